@@ -0,0 +1,564 @@
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <sys/resource.h>
+#include <igraph.h>
+
+#include "graph_manager.hpp"
+#include "graph_generators.hpp"
+
+
+// Synthetic lists of the compressed adjacency round-trip check (a few blocks, unaligned end):
+#define ROUND_TRIP_LISTS (3 * COMPRESSED_BLOCK + 5)
+
+
+/**
+ ** BenchParams structure:
+ **     Command line parameters of vls_bench.
+ **/
+
+struct BenchParams
+{
+    std::vector<Bench::GraphModel> models; // generated graph families.
+    Bench::GeneratorParams generator; // scale, edge factor and seed of the graphs.
+    Spanner::SpannerParams spanner; // BFS number, backend, ordering, threads.
+    size_t eval_sources_nb = 16; // sources of the stretch evaluation phase.
+    uint32_t baswana_sen_k = 0; // stretch parameter of the Baswana-Sen comparison (0 to skip it).
+    std::string format = "csv"; // report format: csv or json.
+    std::string output; // report file (standard output if empty).
+    std::string workdir = "/tmp"; // directory of the generated graph files.
+};
+
+
+/**
+ ** PhaseRecord structure:
+ **     Measures of one phase on one graph.
+ **/
+
+struct PhaseRecord
+{
+    std::string graph;
+    std::string phase;
+    uint64_t vertices_nb; // vertices of the graph processed by the phase.
+    uint64_t edges_nb; // edges of the graph processed by the phase.
+    double wall_s; // wall time of the phase in seconds.
+    double edges_per_s; // processed edges (see run_phase) per second.
+    long peak_rss_kb; // peak resident memory of the process at the end of the phase.
+    uint64_t adjacency_bytes; // neighbors lists size built by the phase (csr and compress phases).
+};
+
+
+static void print_help()
+{
+    std::cout << "usage: ./vls_bench [--graph <model>] [--scale <s>] [--edge-factor <f>] [--seed <seed>]\n"
+        << "                   [--bfs-number <nb>] [--bfs-backend <backend>] [--vertex-order <order>] [--threads <nb>]\n"
+        << "                   [--eval <K>] [--k <k>] [--format csv|json] [--output <file>] [--workdir <dir>]\n\n"
+        << "Options description:\n"
+        << "--graph <model>:\t\tgenerated graph: er, ba, rmat, grid or all (default).\n"
+        << "--scale <s>:\t\t\tthe graphs have about 2^s vertices (default 16).\n"
+        << "--edge-factor <f>:\t\tabout f edges per vertex (default 8, ignored by grid).\n"
+        << "--seed <seed>:\t\t\tseed of the generators (default 42).\n"
+        << "--bfs-number <nb>:\t\tnumber of BFS of the spanner (default 50).\n"
+        << "--bfs-backend <backend>:\tigraph, queue (default), bit-parallel or direction-optimizing.\n"
+        << "--vertex-order <order>:\t\tnatural (default), degree or bfs relabeling of the CSR graph.\n"
+        << "--threads <nb>:\t\t\tnumber of threads (default: number of cores).\n"
+        << "--eval <K>:\t\t\tsampled sources of the evaluation phase (default 16).\n"
+        << "--k <k>:\t\t\talso build and evaluate a Baswana-Sen (2k-1)-spanner of each GCC.\n"
+        << "--format <format>:\t\treport format, csv (default) or json.\n"
+        << "--output <file>:\t\treport file (default: standard output).\n"
+        << "--workdir <dir>:\t\tdirectory of the generated graph files (default /tmp)."
+        << std::endl;
+
+    exit(0);
+}
+
+
+static BenchParams parse_options(int argc, char **argv)
+{
+    BenchParams params;
+    bool all_models = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = std::string(argv[i]);
+
+        if (option == "-h" || option == "--help")
+            print_help();
+
+        if (i + 1 == argc)
+            print_help();
+
+        std::string value = std::string(argv[++i]);
+
+        if (option == "--graph")
+        {
+            all_models = (value == "all");
+            if (value == "er")
+                params.models.push_back(Bench::GraphModel::ERDOS_RENYI);
+            else if (value == "ba")
+                params.models.push_back(Bench::GraphModel::BARABASI_ALBERT);
+            else if (value == "rmat")
+                params.models.push_back(Bench::GraphModel::RMAT);
+            else if (value == "grid")
+                params.models.push_back(Bench::GraphModel::GRID);
+            else if (!all_models)
+            {
+                std::cerr << "Error: unrecognize graph model '" << value << "'" << std::endl;
+                exit(1);
+            }
+        }
+        else if (option == "--scale")
+            params.generator.scale = std::stoi(value);
+        else if (option == "--edge-factor")
+            params.generator.edge_factor = std::stoi(value);
+        else if (option == "--seed")
+            params.generator.seed = std::stoull(value);
+        else if (option == "--bfs-number")
+            params.spanner.bfs_nb = std::stoi(value);
+        else if (option == "--threads")
+            params.spanner.threads_nb = std::stoi(value);
+        else if (option == "--eval")
+            params.eval_sources_nb = std::stoul(value);
+        else if (option == "--k")
+            params.baswana_sen_k = std::stoul(value);
+        else if (option == "--format")
+            params.format = value;
+        else if (option == "--output")
+            params.output = value;
+        else if (option == "--workdir")
+            params.workdir = value;
+        else if (option == "--vertex-order")
+        {
+            if (value == "natural")
+                params.spanner.ordering = Graph::VertexOrdering::NATURAL;
+            else if (value == "degree")
+                params.spanner.ordering = Graph::VertexOrdering::DEGREE;
+            else if (value == "bfs")
+                params.spanner.ordering = Graph::VertexOrdering::BFS;
+            else
+            {
+                std::cerr << "Error: unrecognize vertex order '" << value << "'" << std::endl;
+                exit(1);
+            }
+        }
+        else if (option == "--bfs-backend")
+        {
+            if (value == "igraph")
+                params.spanner.bfs_backend = Spanner::BFS_BACKEND::IGRAPH;
+            else if (value == "queue")
+                params.spanner.bfs_backend = Spanner::BFS_BACKEND::QUEUE;
+            else if (value == "bit-parallel")
+                params.spanner.bfs_backend = Spanner::BFS_BACKEND::BIT_PARALLEL;
+            else if (value == "direction-optimizing")
+                params.spanner.bfs_backend = Spanner::BFS_BACKEND::DIRECTION_OPTIMIZING;
+            else
+            {
+                std::cerr << "Error: unrecognize bfs backend '" << value << "'" << std::endl;
+                exit(1);
+            }
+        }
+        else
+        {
+            std::cerr << "Error: unrecognize option: " << option << std::endl;
+            exit(1);
+        }
+    }
+
+    if (all_models || params.models.empty())
+        params.models = {Bench::GraphModel::ERDOS_RENYI, Bench::GraphModel::BARABASI_ALBERT,
+            Bench::GraphModel::RMAT, Bench::GraphModel::GRID};
+
+    if (params.generator.scale < 1 || params.generator.scale > 31)
+    {
+        std::cerr << "Error: --scale must be between 1 and 31" << std::endl;
+        exit(1);
+    }
+
+    return params;
+}
+
+
+/**
+ ** run_phase():
+ **     params: records -> measures of all the phases.
+ **             graph, phase -> names of the graph and of the phase.
+ **             vertices_nb, edges_nb -> size of the graph processed by the phase.
+ **             step -> callable running the phase and returning its number of processed
+ **                     edges (edges of the graph times the number of traversals).
+ **
+ **     Run one phase with the console output of the library silenced, and record
+ **     its wall time, throughput and the peak RSS of the process.
+ **/
+
+template <typename Step>
+static void run_phase(std::vector<PhaseRecord> *records, std::string graph, std::string phase,
+        uint64_t vertices_nb, uint64_t edges_nb, Step step)
+{
+    std::streambuf *cout_buffer = std::cout.rdbuf(NULL);
+    auto start = std::chrono::steady_clock::now();
+
+    double processed_edges = step();
+
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    std::cout.rdbuf(cout_buffer);
+    std::cout.clear();
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    records->push_back({graph, phase, vertices_nb, edges_nb, wall.count(),
+            wall.count() > 0 ? processed_edges / wall.count() : 0.0, usage.ru_maxrss, 0});
+}
+
+
+/**
+ ** round_trip_errors():
+ **     params: offsets -> start of each neighbors list (vertices + 1 values).
+ **             list -> callable list(v, buffer) returning the sorted neighbors of v.
+ **             pool -> threads encoding and checking the lists.
+ **
+ **     Encode the lists in two ranges (the second one starts inside a block), then
+ **     decode each one with decode() (SSSE3 when available) and decode_scalar().
+ **     Return the number of lists differing from the original ones.
+ **/
+
+template <typename List>
+static size_t round_trip_errors(const std::vector<uint64_t> &offsets, List list, Parallel::ThreadPool &pool)
+{
+    uint32_t vertices_nb = offsets.size() - 1;
+    uint32_t split = (vertices_nb / 2) | 1;
+    uint32_t max_degree = 0;
+    Graph::CompressedAdjacency adjacency;
+
+    for (uint32_t v = 0; v < vertices_nb; v++)
+        max_degree = std::max<uint32_t>(max_degree, offsets[v + 1] - offsets[v]);
+
+    adjacency.append(0, std::min(split, vertices_nb), offsets, list, pool);
+    adjacency.append(std::min(split, vertices_nb), vertices_nb, offsets, list, pool);
+
+    size_t chunks_nb = std::min<size_t>(16 * pool.get_threads_nb(), std::max<uint32_t>(vertices_nb, 1));
+    std::vector<std::vector<uint32_t>> buffers(3 * pool.get_threads_nb(), std::vector<uint32_t>(max_degree));
+    std::atomic<size_t> errors_nb(0);
+
+    pool.run(chunks_nb, [&](size_t chunk, int thread_id)
+    {
+        uint32_t *expected = buffers[3 * thread_id].data();
+        uint32_t *decoded = buffers[3 * thread_id + 1].data();
+        uint32_t *scalar = buffers[3 * thread_id + 2].data();
+
+        for (uint32_t v = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+                v < Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1); v++)
+        {
+            uint32_t degree = offsets[v + 1] - offsets[v];
+            const uint32_t *neighbors = list(v, expected);
+
+            adjacency.decode(v, degree, decoded);
+            adjacency.decode_scalar(v, degree, scalar);
+            if (!std::equal(neighbors, neighbors + degree, decoded) || !std::equal(neighbors, neighbors + degree, scalar))
+                errors_nb++;
+        }
+    });
+
+    return errors_nb;
+}
+
+
+/**
+ ** synthetic_lists():
+ **     params: seed -> seed of the random lists.
+ **             offsets, neighbors -> CSR arrays receiving the lists.
+ **
+ **     ROUND_TRIP_LISTS sorted lists covering the corner cases of the encoding: all
+ **     the degrees modulo 4, first neighbors below their vertex (negative zigzag
+ **     values) or far above it, and gaps of 1 to 4 bytes.
+ **/
+
+static void synthetic_lists(uint64_t seed, std::vector<uint64_t> *offsets, std::vector<uint32_t> *neighbors)
+{
+    std::mt19937_64 rng(seed);
+    static const uint32_t gap_limits[4] = {1U << 8, 1U << 16, 1U << 24, 1U << 31};
+
+    offsets->assign(1, 0);
+    neighbors->clear();
+
+    for (uint32_t v = 0; v < ROUND_TRIP_LISTS; v++)
+    {
+        uint32_t degree = v % 11;
+        uint32_t gap_limit = gap_limits[(v / 11) % 4];
+        uint64_t x = (v % 3 == 0) ? rng() % (v + 1) : (v % 3 == 1) ? v + rng() % gap_limit : v;
+
+        for (uint32_t i = 0; i < degree && x <= UINT32_MAX; i++)
+        {
+            neighbors->push_back(x);
+            x += 1 + rng() % gap_limit;
+        }
+
+        offsets->push_back(neighbors->size());
+    }
+}
+
+
+/**
+ ** check_round_trip():
+ **     params: csr -> CSR graph of the benchmark (plain neighbors lists).
+ **             seed -> seed of the synthetic lists.
+ **             pool -> threads of the check.
+ **
+ **     Check that the synthetic lists and the lists of csr are decoded back
+ **     unchanged by both decoders, exit on error. Return the number of checked
+ **     neighbors.
+ **/
+
+static double check_round_trip(const Graph::CsrGraph &csr, uint64_t seed, Parallel::ThreadPool &pool)
+{
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> neighbors;
+
+    synthetic_lists(seed, &offsets, &neighbors);
+    size_t errors_nb = round_trip_errors(offsets, [&](uint32_t v, uint32_t *)
+    {
+        return neighbors.data() + offsets[v];
+    }, pool);
+    double checked_nb = neighbors.size();
+
+    offsets.assign(1, 0);
+    for (uint32_t v = 0; v < csr.get_vertices_nb(); v++)
+        offsets.push_back(offsets.back() + csr.degree(v));
+
+    errors_nb += round_trip_errors(offsets, [&](uint32_t v, uint32_t *buffer)
+    {
+        return csr.neighbors_of(v, buffer);
+    }, pool);
+    checked_nb += offsets.back();
+
+    if (errors_nb > 0)
+    {
+        std::cerr << "Error: " << errors_nb << " neighbors lists differ after compression" << std::endl;
+        exit(1);
+    }
+
+    return checked_nb;
+}
+
+
+/**
+ ** bench_graph():
+ **     params: model -> generated graph family.
+ **             params -> benchmark parameters.
+ **             records -> measures of all the phases.
+ **
+ **     Generate the graph, write it as a text file, then time each phase of a vls
+ **     run on it: load, GCC, CSR build, source selection, BFS precompute, merge and
+ **     stretch evaluation. The same BFS are then computed on a compressed copy of
+ **     the CSR graph, to compare sizes and traversal speeds, after checking that the
+ **     compressed lists decode back unchanged. With --k, the Baswana-Sen
+ **     spanner of the same GCC is built and evaluated too.
+ **/
+
+static void bench_graph(Bench::GraphModel model, const BenchParams &params, std::vector<PhaseRecord> *records)
+{
+    Bench::GeneratorParams generator = params.generator;
+    generator.model = model;
+
+    std::string name = Bench::model_name(model) + "-" + std::to_string(generator.scale);
+    std::string filename = params.workdir + "/vls_bench_" + name + ".txt";
+    std::vector<uint32_t> edges;
+    uint32_t vertices_nb = 0;
+
+    run_phase(records, name, "generate", 0, 0, [&]()
+    {
+        vertices_nb = Bench::generate_graph(generator, &edges);
+        Bench::write_graph_file(filename, vertices_nb, edges);
+        return edges.size() / 2.0;
+    });
+
+    uint64_t edges_nb = edges.size() / 2;
+    records->back().vertices_nb = vertices_nb;
+    records->back().edges_nb = edges_nb;
+    std::vector<uint32_t>().swap(edges);
+
+    Graph::GraphManager g_manager(params.spanner.threads_nb);
+    Parallel::ThreadPool pool(params.spanner.threads_nb);
+    igraph_t *gcc = NULL;
+
+    run_phase(records, name, "load", vertices_nb, edges_nb, [&]()
+    {
+        g_manager.load_graph(filename);
+        return static_cast<double>(edges_nb);
+    });
+
+    run_phase(records, name, "gcc", vertices_nb, edges_nb, [&]()
+    {
+        gcc = g_manager.compute_gcc();
+        return static_cast<double>(edges_nb);
+    });
+
+    uint64_t gcc_vertices_nb = igraph_vcount(gcc);
+    uint64_t gcc_edges_nb = igraph_ecount(gcc);
+    Graph::CsrGraph csr;
+
+    run_phase(records, name, "csr", gcc_vertices_nb, gcc_edges_nb, [&]()
+    {
+        csr = Graph::CsrGraph(gcc, params.spanner.ordering);
+        return static_cast<double>(gcc_edges_nb);
+    });
+    records->back().adjacency_bytes = csr.adjacency_size();
+
+    std::vector<int> sources_pt;
+
+    run_phase(records, name, "select", gcc_vertices_nb, gcc_edges_nb, [&]()
+    {
+        sources_pt = Spanner::select_bfs_points(gcc, csr, params.spanner, pool);
+        return static_cast<double>(gcc_edges_nb);
+    });
+
+    Spanner::BfsEngine engine(csr, pool);
+    std::vector<Spanner::BfsResult> bfs_vec;
+
+    run_phase(records, name, "bfs", gcc_vertices_nb, gcc_edges_nb, [&]()
+    {
+        Spanner::pre_compute_bfs(gcc, engine, csr, sources_pt, &bfs_vec, params.spanner);
+        return static_cast<double>(bfs_vec.size()) * gcc_edges_nb;
+    });
+
+    Graph::IgraphPtr span;
+
+    run_phase(records, name, "merge", gcc_vertices_nb, gcc_edges_nb, [&]()
+    {
+        Spanner::EdgeAccumulator span_edges(csr.get_vertices_nb(), 2 * static_cast<size_t>(csr.get_vertices_nb()));
+        size_t trees_nb = Spanner::merge_bfs_trees(&span_edges, csr, bfs_vec, params.spanner);
+        span = span_edges.build_igraph(csr);
+        return static_cast<double>(trees_nb) * gcc_vertices_nb;
+    });
+
+    std::vector<Spanner::BfsResult>().swap(bfs_vec);
+
+    run_phase(records, name, "eval", gcc_vertices_nb, gcc_edges_nb, [&]()
+    {
+        Graph::CsrGraph span_csr(span.get());
+        Spanner::StretchStats stats = Spanner::evaluate_stretch(csr, span_csr, pool, params.eval_sources_nb,
+                params.generator.seed);
+        return static_cast<double>(stats.sources_nb) * (gcc_edges_nb + span_csr.get_edges_nb());
+    });
+
+    span.reset();
+
+    // Same BFS on the compressed neighbors lists:
+    {
+        run_phase(records, name, "compress_check", gcc_vertices_nb, gcc_edges_nb, [&]()
+        {
+            return check_round_trip(csr, params.generator.seed, pool);
+        });
+
+
+        Graph::CsrGraph compressed_csr = csr;
+
+        run_phase(records, name, "compress", gcc_vertices_nb, gcc_edges_nb, [&]()
+        {
+            compressed_csr.compress(pool);
+            return static_cast<double>(gcc_edges_nb);
+        });
+        records->back().adjacency_bytes = compressed_csr.adjacency_size();
+
+        Spanner::BfsEngine compressed_engine(compressed_csr, pool);
+
+        run_phase(records, name, "bfs_compressed", gcc_vertices_nb, gcc_edges_nb, [&]()
+        {
+            Spanner::pre_compute_bfs(gcc, compressed_engine, compressed_csr, sources_pt, &bfs_vec, params.spanner);
+            return static_cast<double>(bfs_vec.size()) * gcc_edges_nb;
+        });
+
+        std::vector<Spanner::BfsResult>().swap(bfs_vec);
+    }
+
+    if (params.baswana_sen_k > 0)
+    {
+        run_phase(records, name, "baswana_sen", gcc_vertices_nb, gcc_edges_nb, [&]()
+        {
+            Spanner::EdgeAccumulator span_edges(csr.get_vertices_nb(), 2 * static_cast<size_t>(csr.get_vertices_nb()));
+            Spanner::baswana_sen_spanner(csr, params.baswana_sen_k, params.generator.seed, pool, &span_edges);
+            span = span_edges.build_igraph(csr);
+            return static_cast<double>(params.baswana_sen_k) * gcc_edges_nb;
+        });
+
+        run_phase(records, name, "eval_baswana_sen", gcc_vertices_nb, gcc_edges_nb, [&]()
+        {
+            Graph::CsrGraph span_csr(span.get());
+            Spanner::StretchStats stats = Spanner::evaluate_stretch(csr, span_csr, pool, params.eval_sources_nb,
+                    params.generator.seed);
+            return static_cast<double>(stats.sources_nb) * (gcc_edges_nb + span_csr.get_edges_nb());
+        });
+
+        span.reset();
+    }
+
+    remove(filename.c_str());
+}
+
+
+/**
+ ** write_report():
+ **     Write the records as CSV (one line per phase) or as a JSON array.
+ **/
+
+static void write_report(const std::vector<PhaseRecord> &records, const BenchParams &params)
+{
+    std::ofstream file;
+    if (!params.output.empty())
+    {
+        file.open(params.output);
+        if (!file)
+        {
+            std::cerr << "Error: can't write the report file " << params.output << std::endl;
+            exit(1);
+        }
+    }
+    std::ostream &out = params.output.empty() ? std::cout : file;
+
+    if (params.format == "json")
+    {
+        out << "[\n";
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            const PhaseRecord &r = records[i];
+            out << "  {\"graph\": \"" << r.graph << "\", \"phase\": \"" << r.phase << "\", \"vertices\": "
+                << r.vertices_nb << ", \"edges\": " << r.edges_nb << ", \"wall_s\": " << r.wall_s
+                << ", \"edges_per_s\": " << r.edges_per_s << ", \"peak_rss_kb\": " << r.peak_rss_kb
+                << ", \"adjacency_bytes\": " << r.adjacency_bytes << "}"
+                << (i + 1 < records.size() ? ",\n" : "\n");
+        }
+        out << "]" << std::endl;
+    }
+    else
+    {
+        out << "graph,phase,vertices,edges,wall_s,edges_per_s,peak_rss_kb,adjacency_bytes\n";
+        for (const PhaseRecord &r : records)
+            out << r.graph << ',' << r.phase << ',' << r.vertices_nb << ',' << r.edges_nb << ','
+                << r.wall_s << ',' << r.edges_per_s << ',' << r.peak_rss_kb << ',' << r.adjacency_bytes << '\n';
+        out.flush();
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    BenchParams params = parse_options(argc, argv);
+    std::vector<PhaseRecord> records;
+
+    if (params.format != "csv" && params.format != "json")
+    {
+        std::cerr << "Error: unrecognize report format '" << params.format << "'" << std::endl;
+        exit(1);
+    }
+
+    for (Bench::GraphModel model : params.models)
+        bench_graph(model, params, &records);
+
+    write_report(records, params);
+
+    return 0;
+}
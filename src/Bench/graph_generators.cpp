@@ -0,0 +1,266 @@
+#include "graph_generators.hpp"
+
+#include <random>
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+
+
+// Graph500 R-MAT quadrant probabilities (d = 1 - a - b - c):
+#define RMAT_A 0.57
+#define RMAT_B 0.19
+#define RMAT_C 0.19
+
+// Size of the output buffer of write_graph_file():
+#define WRITE_BUFFER_SIZE (1 << 20)
+
+
+namespace Bench
+{
+
+    /**
+     ** model_name():
+     **     Return the name of a graph model, as given on the command line.
+     **/
+
+    std::string model_name(GraphModel model)
+    {
+        switch (model)
+        {
+        case GraphModel::ERDOS_RENYI:
+            return "er";
+        case GraphModel::BARABASI_ALBERT:
+            return "ba";
+        case GraphModel::RMAT:
+            return "rmat";
+        case GraphModel::GRID:
+            return "grid";
+        }
+
+        return "unknown";
+    }
+
+
+    /**
+     ** erdos_renyi():
+     **     Draw edges_nb uniform random pairs of distinct vertices.
+     **/
+
+    static void erdos_renyi(uint32_t vertices_nb, uint64_t edges_nb, std::mt19937_64 &generator, std::vector<uint64_t> *keys)
+    {
+        std::uniform_int_distribution<uint32_t> vertex(0, vertices_nb - 1);
+
+        for (uint64_t i = 0; i < edges_nb; i++)
+            keys->push_back(static_cast<uint64_t>(vertex(generator)) << 32 | vertex(generator));
+    }
+
+
+    /**
+     ** barabasi_albert():
+     **     Each new vertex is linked to edge_factor vertices chosen with a probability
+     **     proportional to their degree: the targets are drawn from the list of all the
+     **     edge extremities seen so far.
+     **/
+
+    static void barabasi_albert(uint32_t vertices_nb, int edge_factor, std::mt19937_64 &generator, std::vector<uint64_t> *keys)
+    {
+        std::vector<uint32_t> extremities;
+        extremities.reserve(2 * static_cast<size_t>(vertices_nb) * edge_factor);
+
+        for (uint32_t v = 1; v < vertices_nb; v++)
+        {
+            for (int k = 0; k < edge_factor; k++)
+            {
+                uint32_t target = extremities.empty() ? 0
+                    : extremities[std::uniform_int_distribution<size_t>(0, extremities.size() - 1)(generator)];
+
+                keys->push_back(static_cast<uint64_t>(v) << 32 | target);
+                extremities.push_back(v);
+                extremities.push_back(target);
+            }
+        }
+    }
+
+
+    /**
+     ** rmat():
+     **     Draw each edge by descending scale times into one of the four quadrants of
+     **     the adjacency matrix with the probabilities a, b, c and d.
+     **/
+
+    static void rmat(int scale, uint64_t edges_nb, std::mt19937_64 &generator, std::vector<uint64_t> *keys)
+    {
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+        for (uint64_t i = 0; i < edges_nb; i++)
+        {
+            uint32_t u = 0;
+            uint32_t v = 0;
+
+            for (int level = 0; level < scale; level++)
+            {
+                double p = coin(generator);
+                u <<= 1;
+                v <<= 1;
+
+                if (p >= RMAT_A + RMAT_B + RMAT_C)
+                {
+                    u |= 1;
+                    v |= 1;
+                }
+                else if (p >= RMAT_A + RMAT_B)
+                    u |= 1;
+                else if (p >= RMAT_A)
+                    v |= 1;
+            }
+
+            keys->push_back(static_cast<uint64_t>(u) << 32 | v);
+        }
+    }
+
+
+    /**
+     ** grid():
+     **     Link each vertex of a side x side grid to its right and bottom neighbors.
+     **/
+
+    static void grid(uint32_t side, std::vector<uint64_t> *keys)
+    {
+        for (uint32_t row = 0; row < side; row++)
+        {
+            for (uint32_t col = 0; col < side; col++)
+            {
+                uint64_t v = static_cast<uint64_t>(row) * side + col;
+
+                if (col + 1 < side)
+                    keys->push_back(v << 32 | (v + 1));
+                if (row + 1 < side)
+                    keys->push_back(v << 32 | (v + side));
+            }
+        }
+    }
+
+
+    /**
+     ** generate_graph():
+     **     params: params -> graph model, scale, edge factor and seed.
+     **             edges -> flat edge list (u_0, v_0, u_1, v_1, ...) of the graph.
+     **
+     **     Generate a simple undirected graph: self-loops and duplicated edges drawn
+     **     by the models are removed. The same parameters always give the same graph.
+     **     Return the number of vertices.
+     **/
+
+    uint32_t generate_graph(const GeneratorParams &params, std::vector<uint32_t> *edges)
+    {
+        std::mt19937_64 generator(params.seed);
+        uint32_t vertices_nb = static_cast<uint32_t>(1) << params.scale;
+        uint64_t edges_nb = static_cast<uint64_t>(vertices_nb) * params.edge_factor;
+        std::vector<uint64_t> keys;
+
+        switch (params.model)
+        {
+        case GraphModel::ERDOS_RENYI:
+            erdos_renyi(vertices_nb, edges_nb, generator, &keys);
+            break;
+        case GraphModel::BARABASI_ALBERT:
+            barabasi_albert(vertices_nb, params.edge_factor, generator, &keys);
+            break;
+        case GraphModel::RMAT:
+            rmat(params.scale, edges_nb, generator, &keys);
+            break;
+        case GraphModel::GRID:
+        {
+            uint32_t side = std::sqrt(static_cast<double>(vertices_nb));
+            vertices_nb = side * side;
+            grid(side, &keys);
+            break;
+        }
+        }
+
+        // Canonical (min, max) keys, sorted to remove duplicates:
+        for (uint64_t &key : keys)
+        {
+            uint32_t u = key >> 32;
+            uint32_t v = key & UINT32_MAX;
+            key = (u < v) ? (static_cast<uint64_t>(u) << 32 | v) : (static_cast<uint64_t>(v) << 32 | u);
+        }
+
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        edges->clear();
+        edges->reserve(2 * keys.size());
+        for (uint64_t key : keys)
+        {
+            uint32_t u = key >> 32;
+            uint32_t v = key & UINT32_MAX;
+
+            if (u != v)
+            {
+                edges->push_back(u);
+                edges->push_back(v);
+            }
+        }
+
+        return vertices_nb;
+    }
+
+
+    /**
+     ** write_graph_file():
+     **     params: filename -> path of the written file.
+     **             vertices_nb -> number of vertices.
+     **             edges -> flat edge list.
+     **
+     **     Write the graph in the degree/edge-list text format read by vls.
+     **/
+
+    void write_graph_file(std::string filename, uint32_t vertices_nb, const std::vector<uint32_t> &edges)
+    {
+        FILE *f = fopen(filename.c_str(), "w");
+        if (!f)
+        {
+            std::cerr << "Error: can't write the graph file " << filename << std::endl;
+            exit(1);
+        }
+
+        std::vector<uint32_t> degrees(vertices_nb, 0);
+        for (uint32_t v : edges)
+            degrees[v]++;
+
+        std::vector<char> buffer(WRITE_BUFFER_SIZE);
+        char *end = buffer.data() + buffer.size();
+        char *p = buffer.data();
+
+        // flush the buffer when a line may not fit anymore (2 integers and 2 separators).
+        auto write_line = [&](uint32_t a, uint32_t b, bool two_values)
+        {
+            if (end - p < 32)
+            {
+                fwrite(buffer.data(), 1, p - buffer.data(), f);
+                p = buffer.data();
+            }
+
+            p = std::to_chars(p, end, a).ptr;
+            if (two_values)
+            {
+                *p++ = ' ';
+                p = std::to_chars(p, end, b).ptr;
+            }
+            *p++ = '\n';
+        };
+
+        write_line(vertices_nb, 0, false);
+        for (uint32_t v = 0; v < vertices_nb; v++)
+            write_line(v, degrees[v], true);
+        for (size_t i = 0; i < edges.size(); i += 2)
+            write_line(edges[i], edges[i + 1], true);
+
+        fwrite(buffer.data(), 1, p - buffer.data(), f);
+        fclose(f);
+    }
+
+} // namespace Bench
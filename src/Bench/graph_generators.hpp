@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace Bench
+{
+
+    /**
+     ** GraphModel enum:
+     **     Synthetic graph families of the benchmark.
+     **         ERDOS_RENYI -> uniform random edges (G(n, m)).
+     **         BARABASI_ALBERT -> preferential attachment, heavy-tailed degrees.
+     **         RMAT -> recursive matrix (Graph500 parameters), skewed and clustered.
+     **         GRID -> 2D grid, large diameter.
+     **/
+
+    enum GraphModel
+    {
+        ERDOS_RENYI,
+        BARABASI_ALBERT,
+        RMAT,
+        GRID
+    };
+
+
+    /**
+     ** GeneratorParams structure:
+     **     Size and seed of a generated graph.
+     **/
+
+    struct GeneratorParams
+    {
+        GraphModel model = GraphModel::ERDOS_RENYI;
+        int scale = 16; // the graph has about 2^scale vertices.
+        int edge_factor = 8; // about edge_factor edges per vertex (ignored by GRID).
+        uint64_t seed = 42; // seed of the generator.
+    };
+
+
+    std::string model_name(GraphModel model);
+    uint32_t generate_graph(const GeneratorParams &params, std::vector<uint32_t> *edges);
+    void write_graph_file(std::string filename, uint32_t vertices_nb, const std::vector<uint32_t> &edges);
+
+} // namespace Bench
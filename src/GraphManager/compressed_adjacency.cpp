@@ -0,0 +1,265 @@
+#include "compressed_adjacency.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#define COMPRESSED_SSSE3
+#endif
+
+
+namespace Graph
+{
+
+    /**
+     ** StreamVByteTables structure:
+     **     Decoding tables indexed by a control byte (4 lengths of 2 bits):
+     **         lengths -> number of data bytes of the 4 values.
+     **         shuffles -> pshufb mask moving the data bytes to 4 32-bit lanes
+     **                     (0xFF clears the high bytes of the short values).
+     **/
+
+    struct StreamVByteTables
+    {
+        uint8_t lengths[256];
+        uint8_t shuffles[256][16];
+
+        StreamVByteTables()
+        {
+            for (int control = 0; control < 256; control++)
+            {
+                uint8_t pos = 0;
+                for (int lane = 0; lane < 4; lane++)
+                {
+                    int length = ((control >> (2 * lane)) & 3) + 1;
+                    for (int b = 0; b < 4; b++)
+                        this->shuffles[control][4 * lane + b] = (b < length) ? pos + b : 0xFF;
+                    pos += length;
+                }
+                this->lengths[control] = pos;
+            }
+        }
+    };
+
+    static const StreamVByteTables tables;
+
+
+    /**
+     ** zigzag(), unzigzag():
+     **     Map a signed difference to an unsigned value small for small differences.
+     **/
+
+    static inline uint32_t zigzag(int32_t x)
+    {
+        return (static_cast<uint32_t>(x) << 1) ^ static_cast<uint32_t>(x >> 31);
+    }
+
+
+    static inline int32_t unzigzag(uint32_t x)
+    {
+        return static_cast<int32_t>((x >> 1) ^ (0U - (x & 1)));
+    }
+
+
+    /**
+     ** gap():
+     **     params:  v -> vertex of the list.
+     **              neighbors -> sorted neighbors list.
+     **              i -> index of the value.
+     **
+     **     Value stored for the i-th neighbor.
+     **/
+
+    static inline uint32_t gap(uint32_t v, const uint32_t *neighbors, uint32_t i)
+    {
+        if (i == 0)
+            return zigzag(static_cast<int32_t>(neighbors[0] - v));
+
+        return neighbors[i] - neighbors[i - 1];
+    }
+
+
+    /**
+     ** code_of():
+     **     params:  x -> stored value.
+     **
+     **     Number of data bytes of x minus one, its 2 bits in the control byte.
+     **/
+
+    static inline uint32_t code_of(uint32_t x)
+    {
+        return (x < (1U << 8)) ? 0 : (x < (1U << 16)) ? 1 : (x < (1U << 24)) ? 2 : 3;
+    }
+
+
+    /**
+     ** encoded_size():
+     **     params:  v -> vertex of the list.
+     **              neighbors -> sorted neighbors of v.
+     **              degree -> number of neighbors.
+     **
+     **     Return the number of bytes of the encoded list.
+     **/
+
+    size_t encoded_size(uint32_t v, const uint32_t *neighbors, uint32_t degree)
+    {
+        size_t size = (static_cast<size_t>(degree) + 3) / 4;
+        for (uint32_t i = 0; i < degree; i++)
+            size += code_of(gap(v, neighbors, i)) + 1;
+
+        return size;
+    }
+
+
+    /**
+     ** encode_neighbors():
+     **     params:  v -> vertex of the list.
+     **              neighbors -> sorted neighbors of v.
+     **              degree -> number of neighbors.
+     **              out -> encoded_size() bytes receiving the list.
+     **
+     **     The bytes are written one by one, the next list may be written by another
+     **     thread right after this one.
+     **/
+
+    void encode_neighbors(uint32_t v, const uint32_t *neighbors, uint32_t degree, uint8_t *out)
+    {
+        uint8_t *control = out;
+        uint8_t *data = out + (static_cast<size_t>(degree) + 3) / 4;
+
+        memset(control, 0, data - control);
+
+        for (uint32_t i = 0; i < degree; i++)
+        {
+            uint32_t x = gap(v, neighbors, i);
+            uint32_t code = code_of(x);
+
+            control[i / 4] |= code << (2 * (i % 4));
+            for (uint32_t b = 0; b <= code; b++)
+                *data++ = x >> (8 * b);
+        }
+    }
+
+
+    /**
+     ** decode_tail():
+     **     params:  v -> vertex of the list.
+     **              control -> control bytes of the list.
+     **              data -> data bytes of the first value to decode.
+     **              first, degree -> range of the values to decode.
+     **              neighbors -> decoded list, neighbors[first - 1] is set if first > 0.
+     **
+     **     Scalar decoder, used for the whole list without SSSE3 and for the last
+     **     values of an incomplete group.
+     **/
+
+    static void decode_tail(uint32_t v, const uint8_t *control, const uint8_t *data, uint32_t first, uint32_t degree,
+            uint32_t *neighbors)
+    {
+        static const uint32_t masks[4] = {0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+
+        for (uint32_t i = first; i < degree; i++)
+        {
+            uint32_t code = (control[i / 4] >> (2 * (i % 4))) & 3;
+            uint32_t x;
+
+            memcpy(&x, data, sizeof(x));
+            x &= masks[code];
+            data += code + 1;
+
+            neighbors[i] = (i == 0) ? v + unzigzag(x) : neighbors[i - 1] + x;
+        }
+    }
+
+
+#ifdef COMPRESSED_SSSE3
+
+    /**
+     ** decode_ssse3():
+     **     params:  see decode_tail() (whole list).
+     **
+     **     Decode 4 values per control byte: one pshufb spreads their bytes into 32-bit
+     **     lanes, then two shifted additions give the prefix sums of the gaps. The first
+     **     value is a zigzag difference from v: every value of the list is shifted by the
+     **     same correction, added with the running base.
+     **/
+
+    __attribute__((target("ssse3")))
+    static void decode_ssse3(uint32_t v, const uint8_t *control, const uint8_t *data, uint32_t degree,
+            uint32_t *neighbors)
+    {
+        uint32_t groups_nb = degree / 4;
+        __m128i base = _mm_setzero_si128();
+
+        for (uint32_t g = 0; g < groups_nb; g++)
+        {
+            uint8_t c = control[g];
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+            x = _mm_shuffle_epi8(x, _mm_loadu_si128(reinterpret_cast<const __m128i *>(tables.shuffles[c])));
+            data += tables.lengths[c];
+
+            if (g == 0)
+            {
+                uint32_t first = _mm_cvtsi128_si32(x);
+                base = _mm_set1_epi32(v + unzigzag(first) - first);
+            }
+
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi32(x, base);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(neighbors + 4 * g), x);
+            base = _mm_shuffle_epi32(x, 0xFF);
+        }
+
+        decode_tail(v, control, data, 4 * groups_nb, degree, neighbors);
+    }
+
+
+    static bool cpu_has_ssse3()
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3");
+    }
+
+    static const bool has_ssse3 = cpu_has_ssse3();
+
+#endif
+
+
+    /**
+     ** decode():
+     **     params:  v -> vertex of the list.
+     **              degree -> number of neighbors of v.
+     **              neighbors -> buffer of at least degree values receiving the list.
+     **/
+
+    void CompressedAdjacency::decode(uint32_t v, uint32_t degree, uint32_t *neighbors) const
+    {
+#ifdef COMPRESSED_SSSE3
+        if (has_ssse3)
+        {
+            const uint8_t *control = this->list_start(v);
+            decode_ssse3(v, control, control + (static_cast<size_t>(degree) + 3) / 4, degree, neighbors);
+            return;
+        }
+#endif
+
+        this->decode_scalar(v, degree, neighbors);
+    }
+
+
+    /**
+     ** decode_scalar():
+     **     params:  see decode().
+     **
+     **     Scalar decoder, whatever the CPU (fallback of decode() and reference of the
+     **     round-trip checks).
+     **/
+
+    void CompressedAdjacency::decode_scalar(uint32_t v, uint32_t degree, uint32_t *neighbors) const
+    {
+        const uint8_t *control = this->list_start(v);
+        decode_tail(v, control, control + (static_cast<size_t>(degree) + 3) / 4, 0, degree, neighbors);
+    }
+
+}; // namespace Graph
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+
+#include "thread_pool.hpp"
+
+
+// Bytes readable after the last list, so decoders can load whole words:
+#define COMPRESSED_PADDING 16
+
+// Vertices sharing a 64-bit base of their 32-bit list offsets (power of two):
+#define COMPRESSED_BLOCK_SHIFT 8
+#define COMPRESSED_BLOCK (1U << COMPRESSED_BLOCK_SHIFT)
+
+// Neighbors slots gathered per pass when a compressed graph is built by vertex ranges:
+#define COMPRESSED_BUILD_EDGES (1ULL << 26)
+
+
+namespace Graph
+{
+
+    /**
+     ** CompressedAdjacency class:
+     **     Sorted neighbors lists stored as gaps in the stream-VByte format (Lemire et al.).
+     **     The list of v starts with the zigzag difference between its first neighbor and
+     **     v, then the differences between consecutive neighbors. Each list is a block of
+     **     control bytes (2 bits per value: its length in bytes minus one) followed by the
+     **     data bytes, so 4 values are decoded with one shuffle (SSSE3, scalar fallback).
+     **     Degrees are not stored, the caller gives them from its offsets. The start of
+     **     each list is a 32-bit offset from the base of its block of COMPRESSED_BLOCK
+     **     vertices, which halves the offsets next to the lists of sparse graphs.
+     **/
+
+    class CompressedAdjacency
+    {
+        public:
+
+            template <typename List>
+            void append(uint32_t first, uint32_t last, const std::vector<uint64_t> &offsets, List list,
+                    Parallel::ThreadPool &pool);
+            void decode(uint32_t v, uint32_t degree, uint32_t *neighbors) const;
+            void decode_scalar(uint32_t v, uint32_t degree, uint32_t *neighbors) const;
+
+            // Getters:
+            bool empty() const;
+            size_t memory_size() const;
+
+        private:
+
+            const uint8_t *list_start(uint32_t v) const;
+
+            std::vector<uint64_t> block_offsets; // start of each block of COMPRESSED_BLOCK lists in bytes.
+            std::vector<uint32_t> byte_offsets; // start of each list from the start of its block.
+            std::vector<uint8_t> bytes; // concatenated lists, then COMPRESSED_PADDING bytes.
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline bool CompressedAdjacency::empty() const
+    {
+        return this->bytes.empty();
+    }
+
+
+    inline size_t CompressedAdjacency::memory_size() const
+    {
+        return this->block_offsets.size() * sizeof(uint64_t) + this->byte_offsets.size() * sizeof(uint32_t)
+            + this->bytes.size();
+    }
+
+
+    inline const uint8_t *CompressedAdjacency::list_start(uint32_t v) const
+    {
+        return this->bytes.data() + this->block_offsets[v >> COMPRESSED_BLOCK_SHIFT] + this->byte_offsets[v];
+    }
+
+
+    /**
+     ** Compressed adjacency useful functions:
+     **/
+
+    size_t encoded_size(uint32_t v, const uint32_t *neighbors, uint32_t degree);
+    void encode_neighbors(uint32_t v, const uint32_t *neighbors, uint32_t degree, uint8_t *out);
+
+
+    /**
+     ** append():
+     **     params:  first, last -> range of the vertices appended, first is the number of
+     **                             vertices already stored.
+     **              offsets -> start of each neighbors list in edge slots (degrees).
+     **              list -> callable list(v, buffer) returning the sorted neighbors of v,
+     **                      either its own array or buffer (degree(v) values) filled.
+     **              pool -> threads encoding the lists.
+     **
+     **     Encode the lists of a vertex range in two parallel passes: the size of
+     **     each list, then the lists at their final position. list() is called twice
+     **     per vertex. The range does not have to start on a block boundary.
+     **/
+
+    template <typename List>
+    void CompressedAdjacency::append(uint32_t first, uint32_t last, const std::vector<uint64_t> &offsets, List list,
+            Parallel::ThreadPool &pool)
+    {
+        // Size of the lists already stored, the padding moves to the end of the new ones:
+        size_t end = this->bytes.empty() ? 0 : this->bytes.size() - COMPRESSED_PADDING;
+
+        this->byte_offsets.resize(last);
+        if (first == last)
+        {
+            this->bytes.resize(end + COMPRESSED_PADDING, 0);
+            return;
+        }
+
+        uint32_t max_degree = 0;
+        for (uint32_t v = first; v < last; v++)
+            max_degree = std::max<uint32_t>(max_degree, offsets[v + 1] - offsets[v]);
+
+        std::vector<std::vector<uint32_t>> buffers(pool.get_threads_nb(), std::vector<uint32_t>(max_degree));
+        size_t chunks_nb = std::min<size_t>(16 * pool.get_threads_nb(), last - first);
+        std::vector<uint64_t> sizes(last - first);
+
+        pool.run(chunks_nb, [&](size_t chunk, int thread_id)
+        {
+            for (uint32_t v = first + Parallel::chunk_begin(last - first, chunks_nb, chunk);
+                    v < first + Parallel::chunk_begin(last - first, chunks_nb, chunk + 1); v++)
+            {
+                uint32_t degree = offsets[v + 1] - offsets[v];
+                sizes[v - first] = encoded_size(v, list(v, buffers[thread_id].data()), degree);
+            }
+        });
+
+        for (uint32_t v = first; v < last; v++)
+        {
+            if (v % COMPRESSED_BLOCK == 0)
+                this->block_offsets.push_back(end);
+
+            uint64_t offset = end - this->block_offsets[v >> COMPRESSED_BLOCK_SHIFT];
+            if (offset > UINT32_MAX)
+            {
+                std::cerr << "Error: more than 4 GiB of compressed lists in a block of " << COMPRESSED_BLOCK
+                    << " vertices" << std::endl;
+                exit(1);
+            }
+
+            this->byte_offsets[v] = offset;
+            end += sizes[v - first];
+        }
+
+        this->bytes.resize(end + COMPRESSED_PADDING, 0);
+
+        pool.run(chunks_nb, [&](size_t chunk, int thread_id)
+        {
+            for (uint32_t v = first + Parallel::chunk_begin(last - first, chunks_nb, chunk);
+                    v < first + Parallel::chunk_begin(last - first, chunks_nb, chunk + 1); v++)
+            {
+                uint32_t degree = offsets[v + 1] - offsets[v];
+                encode_neighbors(v, list(v, buffers[thread_id].data()), degree,
+                        this->bytes.data() + this->block_offsets[v >> COMPRESSED_BLOCK_SHIFT] + this->byte_offsets[v]);
+            }
+        });
+    }
+
+}; // namespace Graph
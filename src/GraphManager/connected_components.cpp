@@ -0,0 +1,243 @@
+#include "connected_components.hpp"
+
+
+namespace Graph
+{
+
+    /**
+     ** ConcurrentUnionFind class constructor:
+     **     params: vertices_nb -> number of vertices.
+     **             pool -> threads initializing the forest.
+     **
+     **     Every vertex starts as the root of its own tree.
+     **/
+
+    ConcurrentUnionFind::ConcurrentUnionFind(uint32_t vertices_nb, Parallel::ThreadPool &pool)
+        : vertices_nb(vertices_nb), parents(new std::atomic<uint32_t>[vertices_nb])
+    {
+        size_t chunks_nb = 4 * pool.get_threads_nb();
+
+        pool.run(chunks_nb, [this, chunks_nb](size_t chunk, int)
+        {
+            uint32_t first = Parallel::chunk_begin(this->vertices_nb, chunks_nb, chunk);
+            uint32_t last = Parallel::chunk_begin(this->vertices_nb, chunks_nb, chunk + 1);
+
+            for (uint32_t v = first; v < last; v++)
+                this->parents[v].store(v, std::memory_order_relaxed);
+        });
+    }
+
+
+    /**
+     ** find():
+     **     params: v -> vertex id.
+     **
+     **     Return the current root of v, with path halving. Concurrent halving writes only
+     **     replace a parent by one of its ancestors, so they never break a tree.
+     **/
+
+    uint32_t ConcurrentUnionFind::find(uint32_t v)
+    {
+        uint32_t parent = this->parents[v].load(std::memory_order_relaxed);
+
+        while (parent != v)
+        {
+            uint32_t grand_parent = this->parents[parent].load(std::memory_order_relaxed);
+            if (grand_parent != parent)
+                this->parents[v].compare_exchange_weak(parent, grand_parent, std::memory_order_relaxed);
+
+            v = parent;
+            parent = this->parents[v].load(std::memory_order_relaxed);
+        }
+
+        return v;
+    }
+
+
+    /**
+     ** unite():
+     **     params: u, v -> extremities of an edge.
+     **
+     **     Merge the trees of u and v: the root with the largest id is hooked under the
+     **     other one. The hook fails and is retried if the root was hooked meanwhile.
+     **/
+
+    void ConcurrentUnionFind::unite(uint32_t u, uint32_t v)
+    {
+        while (true)
+        {
+            u = this->find(u);
+            v = this->find(v);
+
+            if (u == v)
+                return;
+
+            if (u < v)
+                std::swap(u, v);
+
+            uint32_t expected = u;
+            if (this->parents[u].compare_exchange_strong(expected, v, std::memory_order_acq_rel))
+                return;
+        }
+    }
+
+
+    /**
+     ** compress():
+     **     params: pool -> threads compressing the forest.
+     **
+     **     Point every vertex directly to its root, once all unite() calls are done.
+     **/
+
+    void ConcurrentUnionFind::compress(Parallel::ThreadPool &pool)
+    {
+        size_t chunks_nb = 4 * pool.get_threads_nb();
+
+        pool.run(chunks_nb, [this, chunks_nb](size_t chunk, int)
+        {
+            uint32_t first = Parallel::chunk_begin(this->vertices_nb, chunks_nb, chunk);
+            uint32_t last = Parallel::chunk_begin(this->vertices_nb, chunks_nb, chunk + 1);
+
+            for (uint32_t v = first; v < last; v++)
+                this->parents[v].store(this->find(v), std::memory_order_relaxed);
+        });
+    }
+
+
+    /**
+     ** largest_component():
+     **     params: component_size -> size of the largest component.
+     **
+     **     Return the root (smallest vertex id) of the largest component, the first one
+     **     in vertex order in case of tie. compress() must have been called.
+     **/
+
+    uint32_t ConcurrentUnionFind::largest_component(uint32_t *component_size)
+    {
+        std::vector<uint32_t> sizes(this->vertices_nb, 0);
+        uint32_t largest = 0;
+
+        for (uint32_t v = 0; v < this->vertices_nb; v++)
+            sizes[this->label(v)]++;
+
+        for (uint32_t v = 1; v < this->vertices_nb; v++)
+            if (sizes[v] > sizes[largest])
+                largest = v;
+
+        *component_size = this->vertices_nb ? sizes[largest] : 0;
+
+        return largest;
+    }
+
+
+    /**
+     ** component_vertices():
+     **     params: union_find -> compressed union-find of the graph.
+     **             root -> root of the selected component.
+     **             pool -> threads building the maps.
+     **             component_to_original -> original id of each component vertex.
+     **             original_to_component -> component id of each original vertex (NO_VERTEX
+     **                                      outside of the component).
+     **
+     **     Number the component vertices compactly, keeping the original vertex order.
+     **     Each chunk counts its members, then writes them at their final position.
+     **/
+
+    void component_vertices(const ConcurrentUnionFind &union_find, uint32_t root, Parallel::ThreadPool &pool,
+            std::vector<uint32_t> *component_to_original, std::vector<uint32_t> *original_to_component)
+    {
+        uint32_t vertices_nb = union_find.get_vertices_nb();
+        size_t chunks_nb = 4 * pool.get_threads_nb();
+        std::vector<uint32_t> chunk_start(chunks_nb + 1, 0);
+
+        original_to_component->resize(vertices_nb);
+
+        pool.run(chunks_nb, [&](size_t chunk, int)
+        {
+            uint32_t first = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+            uint32_t last = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1);
+
+            for (uint32_t v = first; v < last; v++)
+                if (union_find.label(v) == root)
+                    chunk_start[chunk + 1]++;
+        });
+
+        for (size_t chunk = 0; chunk < chunks_nb; chunk++)
+            chunk_start[chunk + 1] += chunk_start[chunk];
+
+        component_to_original->resize(chunk_start[chunks_nb]);
+
+        pool.run(chunks_nb, [&](size_t chunk, int)
+        {
+            uint32_t first = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+            uint32_t last = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1);
+            uint32_t pos = chunk_start[chunk];
+
+            for (uint32_t v = first; v < last; v++)
+            {
+                if (union_find.label(v) == root)
+                {
+                    (*component_to_original)[pos] = v;
+                    (*original_to_component)[v] = pos++;
+                }
+                else
+                    (*original_to_component)[v] = NO_VERTEX;
+            }
+        });
+    }
+
+
+    /**
+     ** component_edges():
+     **     params: edges -> flat edge list of the graph (u_0, v_0, u_1, v_1, ...).
+     **             edges_nb -> number of edges of the list.
+     **             original_to_component -> component id of each vertex (NO_VERTEX outside).
+     **             pool -> threads gathering the edges.
+     **             res_edges -> initialized vector receiving the component edges.
+     **
+     **     Gather the edges of the component in component ids, keeping the edge order,
+     **     with a parallel count then a parallel write at the final positions.
+     **/
+
+    void component_edges(const igraph_real_t *edges, size_t edges_nb, const std::vector<uint32_t> &original_to_component,
+            Parallel::ThreadPool &pool, igraph_vector_t *res_edges)
+    {
+        size_t chunks_nb = 4 * pool.get_threads_nb();
+        std::vector<size_t> chunk_start(chunks_nb + 1, 0);
+
+        pool.run(chunks_nb, [&](size_t chunk, int)
+        {
+            size_t first = Parallel::chunk_begin(edges_nb, chunks_nb, chunk);
+            size_t last = Parallel::chunk_begin(edges_nb, chunks_nb, chunk + 1);
+
+            // both extremities of an edge are in the same component.
+            for (size_t i = first; i < last; i++)
+                if (original_to_component[static_cast<uint32_t>(edges[2 * i])] != NO_VERTEX)
+                    chunk_start[chunk + 1]++;
+        });
+
+        for (size_t chunk = 0; chunk < chunks_nb; chunk++)
+            chunk_start[chunk + 1] += chunk_start[chunk];
+
+        igraph_vector_resize(res_edges, 2 * chunk_start[chunks_nb]);
+        igraph_real_t *res_data = VECTOR(*res_edges);
+
+        pool.run(chunks_nb, [&](size_t chunk, int)
+        {
+            size_t first = Parallel::chunk_begin(edges_nb, chunks_nb, chunk);
+            size_t last = Parallel::chunk_begin(edges_nb, chunks_nb, chunk + 1);
+            size_t pos = 2 * chunk_start[chunk];
+
+            for (size_t i = first; i < last; i++)
+            {
+                uint32_t u = original_to_component[static_cast<uint32_t>(edges[2 * i])];
+                if (u == NO_VERTEX)
+                    continue;
+
+                res_data[pos++] = u;
+                res_data[pos++] = original_to_component[static_cast<uint32_t>(edges[2 * i + 1])];
+            }
+        });
+    }
+
+} // namespace Graph
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <igraph.h>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+
+namespace Graph
+{
+
+    /**
+     ** ConcurrentUnionFind class:
+     **     Lock-free union-find (Shiloach-Vishkin style hooking) shared by several threads.
+     **     unite() always hooks the root with the largest id under the other root with a
+     **     compare-and-swap, so the root of a component is its smallest vertex id whatever
+     **     the threads interleaving. After compress(), label(v) is the root of v.
+     **/
+
+    class ConcurrentUnionFind
+    {
+        public:
+
+            ConcurrentUnionFind(uint32_t vertices_nb, Parallel::ThreadPool &pool);
+
+            uint32_t find(uint32_t v);
+            void unite(uint32_t u, uint32_t v);
+            void compress(Parallel::ThreadPool &pool);
+            uint32_t largest_component(uint32_t *component_size);
+
+            // Getters:
+            uint32_t get_vertices_nb() const;
+            uint32_t label(uint32_t v) const;
+
+        private:
+
+            uint32_t vertices_nb; // number of vertices.
+            std::unique_ptr<std::atomic<uint32_t>[]> parents; // parent of each vertex in its tree.
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline uint32_t ConcurrentUnionFind::get_vertices_nb() const
+    {
+        return this->vertices_nb;
+    }
+
+
+    inline uint32_t ConcurrentUnionFind::label(uint32_t v) const
+    {
+        return this->parents[v].load(std::memory_order_relaxed);
+    }
+
+
+    /**
+     ** Connected components useful functions:
+     **/
+
+    void component_vertices(const ConcurrentUnionFind &union_find, uint32_t root, Parallel::ThreadPool &pool,
+            std::vector<uint32_t> *component_to_original, std::vector<uint32_t> *original_to_component);
+    void component_edges(const igraph_real_t *edges, size_t edges_nb, const std::vector<uint32_t> &original_to_component,
+            Parallel::ThreadPool &pool, igraph_vector_t *res_edges);
+
+} // namespace Graph
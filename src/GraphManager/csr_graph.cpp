@@ -0,0 +1,325 @@
+#include "csr_graph.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+
+namespace Graph
+{
+
+    /**
+     ** CsrGraph class constructors:
+     **     params: g -> igraph structure to convert.
+     **             vertices_nb -> number of vertices of the edge list.
+     **             edges -> flat edge list (u_0, v_0, u_1, v_1, ...).
+     **             offsets, neighbors -> CSR arrays already filled (lists in any order),
+     **                                   taken over without copy.
+     **             adjacency -> compressed sorted lists of the offsets, taken over.
+     **             ordering -> relabeling applied to vertices.
+     **             pool -> threads encoding the relabeled compressed lists.
+     **
+     **     Build the CSR arrays once from the edge list of the graph.
+     **/
+
+    CsrGraph::CsrGraph()
+        : vertices_nb(0), max_degree(0), offsets(1, 0)
+    {
+    }
+
+
+    CsrGraph::CsrGraph(igraph_t *g, VertexOrdering ordering)
+        : vertices_nb(igraph_vcount(g))
+    {
+        igraph_integer_t edges_nb = igraph_ecount(g);
+        std::vector<uint32_t> edges(2 * static_cast<size_t>(edges_nb));
+
+        {
+            IgraphVector edge_list(2 * edges_nb);
+            igraph_get_edgelist(g, edge_list.get(), false);
+
+            for (size_t i = 0; i < edges.size(); i++)
+                edges[i] = edge_list.data()[i];
+        }
+
+        this->build(edges);
+        this->find_max_degree();
+        this->relabel(ordering);
+    }
+
+
+    CsrGraph::CsrGraph(uint32_t vertices_nb, const std::vector<uint32_t> &edges, VertexOrdering ordering)
+        : vertices_nb(vertices_nb)
+    {
+        this->build(edges);
+        this->find_max_degree();
+        this->relabel(ordering);
+    }
+
+
+    CsrGraph::CsrGraph(uint32_t vertices_nb, std::vector<uint64_t> &&offsets, std::vector<uint32_t> &&neighbors,
+            VertexOrdering ordering)
+        : vertices_nb(vertices_nb), offsets(std::move(offsets)), neighbors(std::move(neighbors))
+    {
+        this->sort_neighbors();
+        this->find_max_degree();
+        this->relabel(ordering);
+    }
+
+
+    CsrGraph::CsrGraph(uint32_t vertices_nb, std::vector<uint64_t> &&offsets, CompressedAdjacency &&adjacency,
+            VertexOrdering ordering, Parallel::ThreadPool &pool)
+        : vertices_nb(vertices_nb), offsets(std::move(offsets)), compressed(std::move(adjacency))
+    {
+        this->find_max_degree();
+        this->relabel(ordering, &pool);
+    }
+
+
+    /**
+     ** build():
+     **     params: edges -> flat edge list (u_0, v_0, u_1, v_1, ...).
+     **
+     **     Fill offsets and neighbors arrays by counting sort of the edge list,
+     **     then sort each neighbors list.
+     **/
+
+    void CsrGraph::build(const std::vector<uint32_t> &edges)
+    {
+        this->offsets.assign(static_cast<size_t>(this->vertices_nb) + 1, 0);
+        for (uint32_t v : edges)
+            this->offsets[v + 1]++;
+
+        for (uint32_t v = 0; v < this->vertices_nb; v++)
+            this->offsets[v + 1] += this->offsets[v];
+
+        this->neighbors.resize(edges.size());
+        std::vector<uint64_t> cursor(this->offsets.begin(), this->offsets.end() - 1);
+
+        for (size_t i = 0; i < edges.size(); i += 2)
+        {
+            uint32_t u = edges[i];
+            uint32_t v = edges[i + 1];
+            this->neighbors[cursor[u]++] = v;
+            this->neighbors[cursor[v]++] = u;
+        }
+
+        this->sort_neighbors();
+    }
+
+
+    /**
+     ** find_max_degree():
+     **     Compute the largest degree once the offsets are built (a relabeling keeps it).
+     **/
+
+    void CsrGraph::find_max_degree()
+    {
+        this->max_degree = 0;
+        for (uint32_t v = 0; v < this->vertices_nb; v++)
+            this->max_degree = std::max(this->max_degree, this->degree(v));
+    }
+
+
+    /**
+     ** sort_neighbors():
+     **     Sort each neighbors list, so traversals do not depend on the edge order.
+     **/
+
+    void CsrGraph::sort_neighbors()
+    {
+        for (uint32_t v = 0; v < this->vertices_nb; v++)
+            std::sort(this->neighbors.begin() + this->offsets[v], this->neighbors.begin() + this->offsets[v + 1]);
+    }
+
+
+    /**
+     ** compress():
+     **     params: pool -> threads encoding the lists.
+     **
+     **     Replace the neighbors array by its compressed version (see
+     **     compressed_adjacency.hpp). Traversals then go through neighbors_of().
+     **/
+
+    void CsrGraph::compress(Parallel::ThreadPool &pool)
+    {
+        if (this->is_compressed())
+            return;
+
+        this->compressed.append(0, this->vertices_nb, this->offsets, [this](uint32_t v, uint32_t *)
+        {
+            return this->neighbors.data() + this->offsets[v];
+        }, pool);
+
+        std::vector<uint32_t>().swap(this->neighbors);
+    }
+
+
+    /**
+     ** relabel():
+     **     params: ordering -> relabeling applied to vertices.
+     **             pool -> threads encoding the lists of a compressed graph.
+     **
+     **     Compute the new vertex numbering and rebuild the CSR arrays with it.
+     **     Vertices close in the new numbering are close in memory, which improves
+     **     the cache behavior of traversals. A compressed graph is encoded again
+     **     with the new numbering.
+     **/
+
+    void CsrGraph::relabel(VertexOrdering ordering, Parallel::ThreadPool *pool)
+    {
+        if (ordering == VertexOrdering::NATURAL || this->vertices_nb == 0)
+            return;
+
+        std::vector<uint32_t> order(this->vertices_nb);
+
+        if (ordering == VertexOrdering::DEGREE)
+        {
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+            {
+                return this->degree(a) > this->degree(b);
+            });
+        }
+        else
+        {
+            // BFS order from the highest degree vertex, restarted on each unreached component.
+            std::vector<bool> visited(this->vertices_nb, false);
+            size_t head = 0;
+            size_t tail = 0;
+
+            uint32_t root = 0;
+            for (uint32_t v = 1; v < this->vertices_nb; v++)
+                if (this->degree(v) > this->degree(root))
+                    root = v;
+
+            uint32_t next_root = 0;
+            std::vector<uint32_t> buffer(this->neighbors_buffer_size());
+            while (tail < this->vertices_nb)
+            {
+                if (head == tail)
+                {
+                    while (visited[root])
+                        root = next_root++;
+                    visited[root] = true;
+                    order[tail++] = root;
+                }
+
+                uint32_t u = order[head++];
+                const uint32_t *first = this->neighbors_of(u, buffer.data());
+                for (const uint32_t *it = first; it != first + this->degree(u); it++)
+                {
+                    if (!visited[*it])
+                    {
+                        visited[*it] = true;
+                        order[tail++] = *it;
+                    }
+                }
+            }
+        }
+
+        // Build the relabeled arrays:
+        this->original_to_internal.resize(this->vertices_nb);
+        for (uint32_t v = 0; v < this->vertices_nb; v++)
+            this->original_to_internal[order[v]] = v;
+
+        std::vector<uint64_t> new_offsets(static_cast<size_t>(this->vertices_nb) + 1, 0);
+        for (uint32_t v = 0; v < this->vertices_nb; v++)
+            new_offsets[v + 1] = new_offsets[v] + this->degree(order[v]);
+
+        if (this->is_compressed())
+        {
+            // Decode the list of the old vertex, renumbered and sorted in the buffer:
+            CompressedAdjacency new_compressed;
+            new_compressed.append(0, this->vertices_nb, new_offsets, [this, &order](uint32_t v, uint32_t *buffer)
+            {
+                uint32_t degree = this->degree(order[v]);
+                this->compressed.decode(order[v], degree, buffer);
+                for (uint32_t i = 0; i < degree; i++)
+                    buffer[i] = this->original_to_internal[buffer[i]];
+
+                std::sort(buffer, buffer + degree);
+                return buffer;
+            }, *pool);
+
+            this->compressed = std::move(new_compressed);
+        }
+        else
+        {
+            std::vector<uint32_t> new_neighbors(this->neighbors.size());
+            for (uint32_t v = 0; v < this->vertices_nb; v++)
+            {
+                uint64_t pos = new_offsets[v];
+                for (const uint32_t *it = this->neighbors.data() + this->offsets[order[v]];
+                        it != this->neighbors.data() + this->offsets[order[v] + 1]; it++)
+                    new_neighbors[pos++] = this->original_to_internal[*it];
+
+                std::sort(new_neighbors.begin() + new_offsets[v], new_neighbors.begin() + pos);
+            }
+
+            this->neighbors.swap(new_neighbors);
+        }
+
+        this->offsets.swap(new_offsets);
+        this->internal_to_original.swap(order);
+    }
+
+
+    /**
+     ** to_igraph():
+     **     Create the igraph version of the CSR graph, with original ids. Each
+     **     undirected edge is taken once, a self-loop once every two occurrences.
+     **/
+
+    IgraphPtr CsrGraph::to_igraph() const
+    {
+        IgraphVector edges(2 * this->get_edges_nb());
+        std::vector<uint32_t> buffer(this->neighbors_buffer_size());
+        size_t pos = 0;
+
+        for (uint32_t u = 0; u < this->vertices_nb; u++)
+        {
+            bool loop_parity = false;
+            const uint32_t *first = this->neighbors_of(u, buffer.data());
+            for (const uint32_t *it = first; it != first + this->degree(u); it++)
+            {
+                if (*it == u)
+                {
+                    loop_parity = !loop_parity;
+                    if (!loop_parity)
+                        continue;
+                }
+                if (*it >= u)
+                {
+                    edges.data()[pos++] = this->to_original(u);
+                    edges.data()[pos++] = this->to_original(*it);
+                }
+            }
+        }
+
+        return create_igraph(edges, this->vertices_nb);
+    }
+
+
+    /**
+     ** memory_size():
+     **     Return the number of bytes used by the CSR arrays.
+     **/
+
+    size_t CsrGraph::memory_size() const
+    {
+        return this->offsets.size() * sizeof(uint64_t) + this->adjacency_size()
+            + (this->internal_to_original.size() + this->original_to_internal.size()) * sizeof(uint32_t);
+    }
+
+
+    /**
+     ** adjacency_size():
+     **     Return the number of bytes used by the neighbors lists, plain or compressed.
+     **/
+
+    size_t CsrGraph::adjacency_size() const
+    {
+        return this->neighbors.size() * sizeof(uint32_t) + this->compressed.memory_size();
+    }
+
+} // namespace Graph
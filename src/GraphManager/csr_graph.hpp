@@ -0,0 +1,169 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <igraph.h>
+
+#include "igraph_handle.hpp"
+#include "compressed_adjacency.hpp"
+#include "thread_pool.hpp"
+
+
+// Marker of a missing vertex (no parent, unreached vertex ...):
+#define NO_VERTEX UINT32_MAX
+
+
+namespace Graph
+{
+
+    /**
+     ** VertexOrdering enum:
+     **     Relabeling applied to the vertices when the CSR graph is built.
+     **         NATURAL -> keep the igraph ids.
+     **         DEGREE -> sort vertices by decreasing degree (hubs share cache lines).
+     **         BFS -> number vertices in BFS order from the highest degree vertex.
+     **/
+
+    enum VertexOrdering
+    {
+        NATURAL,
+        DEGREE,
+        BFS
+    };
+
+
+    /**
+     ** CsrGraph class:
+     **     Compressed Sparse Row view of an undirected graph with 32-bit vertex ids.
+     **     Neighbors of vertex v are stored sorted and contiguously between
+     **     offsets[v] and offsets[v + 1]. Each undirected edge appears in the list
+     **     of both extremities. Vertex ids are internal ids, to_original() and
+     **     to_internal() translate them when a relabeling is applied.
+     **     After compress(), the lists are only kept as a CompressedAdjacency and
+     **     neighbors_of() decodes them into the buffer of the caller.
+     **/
+
+    class CsrGraph
+    {
+        public:
+
+            CsrGraph();
+            CsrGraph(igraph_t *g, VertexOrdering ordering = VertexOrdering::NATURAL);
+            CsrGraph(uint32_t vertices_nb, const std::vector<uint32_t> &edges,
+                    VertexOrdering ordering = VertexOrdering::NATURAL);
+            CsrGraph(uint32_t vertices_nb, std::vector<uint64_t> &&offsets, std::vector<uint32_t> &&neighbors,
+                    VertexOrdering ordering = VertexOrdering::NATURAL);
+            CsrGraph(uint32_t vertices_nb, std::vector<uint64_t> &&offsets, CompressedAdjacency &&adjacency,
+                    VertexOrdering ordering, Parallel::ThreadPool &pool);
+
+            IgraphPtr to_igraph() const;
+            void compress(Parallel::ThreadPool &pool);
+
+            // Getters:
+            uint32_t get_vertices_nb() const;
+            uint64_t get_edges_nb() const;
+            uint32_t degree(uint32_t v) const;
+            uint32_t get_max_degree() const;
+            const uint32_t *neighbors_of(uint32_t v, uint32_t *buffer) const;
+            uint32_t neighbors_buffer_size() const;
+            bool is_compressed() const;
+            uint32_t to_original(uint32_t v) const;
+            uint32_t to_internal(uint32_t v) const;
+            size_t memory_size() const;
+            size_t adjacency_size() const;
+
+        private:
+
+            uint32_t vertices_nb; // number of vertices.
+            uint32_t max_degree; // largest degree.
+            std::vector<uint64_t> offsets; // start of each neighbors list (vertices_nb + 1 values).
+            std::vector<uint32_t> neighbors; // concatenated sorted neighbors lists (empty once compressed).
+            CompressedAdjacency compressed; // compressed neighbors lists (empty if not compressed).
+            std::vector<uint32_t> internal_to_original; // relabeling (empty for NATURAL).
+            std::vector<uint32_t> original_to_internal; // inverse relabeling (empty for NATURAL).
+
+            // Methods:
+            void build(const std::vector<uint32_t> &edges);
+            void find_max_degree();
+            void sort_neighbors();
+            void relabel(VertexOrdering ordering, Parallel::ThreadPool *pool = NULL);
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline uint32_t CsrGraph::get_vertices_nb() const
+    {
+        return this->vertices_nb;
+    }
+
+
+    inline uint64_t CsrGraph::get_edges_nb() const
+    {
+        return this->offsets[this->vertices_nb] / 2;
+    }
+
+
+    inline uint32_t CsrGraph::degree(uint32_t v) const
+    {
+        return this->offsets[v + 1] - this->offsets[v];
+    }
+
+
+    /**
+     ** neighbors_of():
+     **     params:  v -> vertex.
+     **              buffer -> neighbors_buffer_size() values, used by compressed graphs only.
+     **
+     **     Return the degree(v) sorted neighbors of v: the CSR array itself, or buffer
+     **     filled with the decoded list. The pointer is valid until the next call with
+     **     the same buffer.
+     **/
+
+    inline const uint32_t *CsrGraph::neighbors_of(uint32_t v, uint32_t *buffer) const
+    {
+        if (this->compressed.empty())
+            return this->neighbors.data() + this->offsets[v];
+
+        this->compressed.decode(v, this->degree(v), buffer);
+        return buffer;
+    }
+
+
+    inline uint32_t CsrGraph::get_max_degree() const
+    {
+        return this->max_degree;
+    }
+
+
+    inline uint32_t CsrGraph::neighbors_buffer_size() const
+    {
+        if (this->compressed.empty())
+            return 0;
+
+        return this->get_max_degree();
+    }
+
+
+    inline bool CsrGraph::is_compressed() const
+    {
+        return !this->compressed.empty();
+    }
+
+
+    inline uint32_t CsrGraph::to_original(uint32_t v) const
+    {
+        return this->internal_to_original.empty() ? v : this->internal_to_original[v];
+    }
+
+
+    inline uint32_t CsrGraph::to_internal(uint32_t v) const
+    {
+        return this->original_to_internal.empty() ? v : this->original_to_internal[v];
+    }
+
+}; // namespace Graph
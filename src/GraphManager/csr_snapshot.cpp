@@ -0,0 +1,305 @@
+#include "csr_snapshot.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+namespace Graph
+{
+
+    /**
+     ** CsrSnapshot class constructor:
+     **     params: filename -> path of the snapshot file.
+     **             pool -> threads checking the adjacency.
+     **
+     **     Map the snapshot file in memory and check its header, its size and its
+     **     adjacency (see valid_adjacency()).
+     **/
+
+    CsrSnapshot::CsrSnapshot(std::string filename, Parallel::ThreadPool &pool)
+        : data(NULL), size(0), offsets(NULL), neighbors(NULL), degrees(NULL), original_ids(NULL)
+    {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            std::cerr << "Error: Impossible to open the snapshot filename: " << filename << std::endl;
+            exit(1);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader))
+        {
+            std::cerr << "snapshot: truncated header in " << filename << std::endl;
+            exit(1);
+        }
+        this->size = st.st_size;
+
+        void *mapped = mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED)
+        {
+            std::cerr << "snapshot: mmap() error on " << filename << std::endl;
+            exit(1);
+        }
+        this->data = static_cast<const char *>(mapped);
+
+        memcpy(&(this->header), this->data, sizeof(SnapshotHeader));
+        if (memcmp(this->header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0)
+        {
+            std::cerr << "snapshot: bad magic header in " << filename << std::endl;
+            exit(1);
+        }
+        if (this->header.version != SNAPSHOT_VERSION)
+        {
+            std::cerr << "snapshot: unsupported version " << this->header.version
+                << " (expected " << SNAPSHOT_VERSION << ") in " << filename << std::endl;
+            exit(1);
+        }
+
+        // Locate and check the blocks:
+        uint64_t n = this->header.vertices_nb;
+        size_t offsets_pos = sizeof(SnapshotHeader);
+        size_t neighbors_pos = offsets_pos + (n + 1) * sizeof(uint64_t);
+
+        if (neighbors_pos > this->size)
+        {
+            std::cerr << "snapshot: truncated offsets block in " << filename << std::endl;
+            exit(1);
+        }
+        this->offsets = reinterpret_cast<const uint64_t *>(this->data + offsets_pos);
+
+        uint64_t adjacency_size = this->offsets[n];
+        size_t degrees_pos = neighbors_pos + adjacency_size * sizeof(uint32_t);
+        size_t original_ids_pos = degrees_pos;
+        if (this->header.flags & SNAPSHOT_DEGREES)
+            original_ids_pos += n * sizeof(uint32_t);
+
+        size_t expected_size = original_ids_pos;
+        if (this->header.flags & SNAPSHOT_ORIGINAL_IDS)
+            expected_size += (n + 1) * sizeof(uint32_t);
+
+        if (adjacency_size != 2 * this->header.edges_nb || expected_size != this->size)
+        {
+            std::cerr << "snapshot: inconsistent size in " << filename << std::endl;
+            exit(1);
+        }
+
+        this->neighbors = reinterpret_cast<const uint32_t *>(this->data + neighbors_pos);
+        if (this->header.flags & SNAPSHOT_DEGREES)
+            this->degrees = reinterpret_cast<const uint32_t *>(this->data + degrees_pos);
+        if (this->header.flags & SNAPSHOT_ORIGINAL_IDS)
+            this->original_ids = reinterpret_cast<const uint32_t *>(this->data + original_ids_pos);
+
+        madvise(mapped, this->size, MADV_WILLNEED);
+
+        if (!this->valid_adjacency(pool))
+        {
+            std::cerr << "snapshot: corrupt adjacency in " << filename << std::endl;
+            exit(1);
+        }
+    }
+
+
+    /**
+     ** valid_adjacency():
+     **     params:  pool -> threads checking the arrays.
+     **
+     **     Check in parallel that the offsets start at 0 and never decrease, and that
+     **     every neighbor is a vertex of the graph, so the readers of the lists stay in
+     **     the mapped blocks.
+     **/
+
+    bool CsrSnapshot::valid_adjacency(Parallel::ThreadPool &pool)
+    {
+        uint64_t n = this->header.vertices_nb;
+        uint64_t adjacency_size = this->offsets[n];
+        size_t chunks_nb = 4 * pool.get_threads_nb();
+        std::atomic<bool> valid(this->offsets[0] == 0);
+
+        pool.run(chunks_nb, [&](size_t chunk, int)
+        {
+            bool chunk_valid = true;
+
+            for (uint64_t v = Parallel::chunk_begin(n, chunks_nb, chunk);
+                    v < Parallel::chunk_begin(n, chunks_nb, chunk + 1); v++)
+                chunk_valid &= this->offsets[v] <= this->offsets[v + 1];
+
+            for (uint64_t i = Parallel::chunk_begin(adjacency_size, chunks_nb, chunk);
+                    i < Parallel::chunk_begin(adjacency_size, chunks_nb, chunk + 1); i++)
+                chunk_valid &= this->neighbors[i] < n;
+
+            if (!chunk_valid)
+                valid = false;
+        });
+
+        return valid;
+    }
+
+
+    /**
+     ** CsrSnapshot class destructor:
+     **     unmap the snapshot file.
+     **/
+
+    CsrSnapshot::~CsrSnapshot()
+    {
+        if (this->data)
+            munmap(const_cast<char *>(this->data), this->size);
+    }
+
+
+    /**
+     ** fill_edges():
+     **     params:  edges -> initialized igraph vector receiving the edge list.
+     **              pool -> threads filling the vector.
+     **
+     **     Rebuild the (u, v) edge list of the snapshot graph, each undirected edge once.
+     **     Vertices are split in ranges, each task counts then writes the edges
+     **     of its range at their final place.
+     **/
+
+    void CsrSnapshot::fill_edges(igraph_vector_t *edges, Parallel::ThreadPool &pool)
+    {
+        uint64_t n = this->header.vertices_nb;
+        igraph_vector_resize(edges, 2 * this->header.edges_nb);
+        igraph_real_t *edges_data = VECTOR(*edges);
+
+        size_t ranges_nb = 4 * pool.get_threads_nb();
+        std::vector<uint64_t> ranges(ranges_nb + 1);
+        for (size_t t = 0; t <= ranges_nb; t++)
+            ranges[t] = Parallel::chunk_begin(n, ranges_nb, t);
+
+        std::vector<uint64_t> counts(ranges_nb + 1, 0);
+
+        pool.run(ranges_nb, [&](size_t t, int)
+        {
+            uint64_t count = 0;
+            this->visit_range(ranges[t], ranges[t + 1], [&count](uint64_t, uint32_t) { count++; });
+            counts[t + 1] = count;
+        });
+
+        for (size_t t = 0; t < ranges_nb; t++)
+            counts[t + 1] += counts[t];
+
+        pool.run(ranges_nb, [&](size_t t, int)
+        {
+            uint64_t pos = 2 * counts[t];
+            this->visit_range(ranges[t], ranges[t + 1], [&pos, edges_data](uint64_t u, uint32_t v)
+            {
+                edges_data[pos++] = u;
+                edges_data[pos++] = v;
+            });
+        });
+    }
+
+
+    /**
+     ** is_csr_snapshot():
+     **     params: filename -> path of a graph file.
+     **
+     **     Check if the file starts with the snapshot magic header.
+     **/
+
+    bool is_csr_snapshot(std::string filename)
+    {
+        char magic[SNAPSHOT_MAGIC_SIZE];
+        FILE *f = fopen(filename.c_str(), "rb");
+        if (!f)
+            return false;
+
+        bool res = fread(magic, 1, SNAPSHOT_MAGIC_SIZE, f) == SNAPSHOT_MAGIC_SIZE
+            && memcmp(magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) == 0;
+        fclose(f);
+
+        return res;
+    }
+
+
+    /**
+     ** write_csr_snapshot():
+     **     params: g -> graph to save.
+     **             filename -> path of the snapshot file.
+     **             flags -> SnapshotFlags combination (SNAPSHOT_ORIGINAL_IDS is set from
+     **                      original_ids).
+     **             original_ids -> id of each vertex of g in the input graph, or NULL.
+     **             original_vertices_nb -> number of vertices of the input graph.
+     **
+     **     Build the CSR representation of g by counting sort of its edge list
+     **     and write it as a binary snapshot.
+     **/
+
+    void write_csr_snapshot(igraph_t *g, std::string filename, uint32_t flags,
+            const std::vector<uint32_t> *original_ids, uint32_t original_vertices_nb)
+    {
+        uint64_t n = igraph_vcount(g);
+        uint64_t m = igraph_ecount(g);
+
+        IgraphVector edge_list(2 * m);
+        igraph_get_edgelist(g, edge_list.get(), false);
+
+        // Count degrees then place each edge in both neighbors lists:
+        std::vector<uint64_t> offsets(n + 1, 0);
+        for (uint64_t i = 0; i < 2 * m; i++)
+            offsets[static_cast<uint64_t>(edge_list.data()[i]) + 1]++;
+
+        for (uint64_t u = 0; u < n; u++)
+            offsets[u + 1] += offsets[u];
+
+        std::vector<uint32_t> neighbors(2 * m);
+        std::vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (uint64_t i = 0; i < m; i++)
+        {
+            uint32_t u = edge_list.data()[2 * i];
+            uint32_t v = edge_list.data()[2 * i + 1];
+            neighbors[cursor[u]++] = v;
+            neighbors[cursor[v]++] = u;
+        }
+
+        // Write header and blocks:
+        SnapshotHeader header;
+        memcpy(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+        header.version = SNAPSHOT_VERSION;
+        header.flags = original_ids ? (flags | SNAPSHOT_ORIGINAL_IDS) : (flags & ~SNAPSHOT_ORIGINAL_IDS);
+        header.vertices_nb = n;
+        header.edges_nb = m;
+
+        FILE *f = fopen(filename.c_str(), "wb");
+        if (!f)
+        {
+            std::cerr << "Error: Impossible to open the snapshot filename: " << filename << std::endl;
+            exit(1);
+        }
+
+        bool ok = fwrite(&header, sizeof(SnapshotHeader), 1, f) == 1
+            && fwrite(offsets.data(), sizeof(uint64_t), n + 1, f) == n + 1
+            && fwrite(neighbors.data(), sizeof(uint32_t), 2 * m, f) == 2 * m;
+
+        if (ok && (flags & SNAPSHOT_DEGREES))
+        {
+            std::vector<uint32_t> degrees(n);
+            for (uint64_t u = 0; u < n; u++)
+                degrees[u] = offsets[u + 1] - offsets[u];
+            ok = fwrite(degrees.data(), sizeof(uint32_t), n, f) == n;
+        }
+
+        if (ok && original_ids)
+        {
+            ok = fwrite(original_ids->data(), sizeof(uint32_t), n, f) == n
+                && fwrite(&original_vertices_nb, sizeof(uint32_t), 1, f) == 1;
+        }
+
+        if (fclose(f) != 0 || !ok)
+        {
+            std::cerr << "Error: write error on snapshot file " << filename << std::endl;
+            exit(1);
+        }
+    }
+
+} // namespace Graph
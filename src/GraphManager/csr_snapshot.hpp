@@ -0,0 +1,197 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include <igraph.h>
+
+#include "thread_pool.hpp"
+#include "igraph_handle.hpp"
+
+
+// Binary CSR snapshot format identification:
+#define SNAPSHOT_MAGIC "VLSCSR\x01\x00"
+#define SNAPSHOT_MAGIC_SIZE 8
+#define SNAPSHOT_VERSION 1
+
+
+namespace Graph
+{
+
+    /**
+     ** Snapshot flags stored in the header:
+     **     SNAPSHOT_DEGREES -> a degree block follows the neighbors array.
+     **     SNAPSHOT_GCC -> the stored graph is connected (already a GCC).
+     **     SNAPSHOT_ORIGINAL_IDS -> an original ids block follows (ids of the input graph).
+     **/
+
+    enum SnapshotFlags
+    {
+        SNAPSHOT_DEGREES = 1,
+        SNAPSHOT_GCC = 2,
+        SNAPSHOT_ORIGINAL_IDS = 4
+    };
+
+
+    /**
+     ** SnapshotHeader structure:
+     **     Fixed size header of a binary CSR snapshot file. The file layout is:
+     **         header | offsets (uint64, vertices_nb + 1) | neighbors (uint32, offsets[n])
+     **         | degrees (uint32, vertices_nb, only with SNAPSHOT_DEGREES)
+     **         | original ids (uint32, vertices_nb + 1, only with SNAPSHOT_ORIGINAL_IDS: id of
+     **           each vertex in the input graph, then the number of vertices of the input graph)
+     **     Each undirected edge appears in the neighbors list of both extremities,
+     **     a self-loop appears twice in the list of its vertex.
+     **/
+
+    struct SnapshotHeader
+    {
+        char magic[SNAPSHOT_MAGIC_SIZE];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t vertices_nb;
+        uint64_t edges_nb;
+    };
+
+
+    /**
+     ** CsrSnapshot class:
+     **     Read-only memory-mapped view of a binary CSR snapshot file.
+     **/
+
+    class CsrSnapshot
+    {
+        public:
+
+            CsrSnapshot(std::string filename, Parallel::ThreadPool &pool);
+            ~CsrSnapshot();
+
+            void fill_edges(igraph_vector_t *edges, Parallel::ThreadPool &pool);
+
+            template <typename Visitor>
+            void visit_edges(Parallel::ThreadPool &pool, Visitor visit);
+
+            // Getters:
+            const SnapshotHeader &get_header();
+            const uint64_t *get_offsets();
+            const uint32_t *get_neighbors();
+            const uint32_t *get_degrees();
+            const uint32_t *get_original_ids();
+
+        private:
+
+            const char *data; // mapped content of the file.
+            size_t size; // size of the mapped content.
+
+            SnapshotHeader header; // copy of the file header.
+            const uint64_t *offsets; // CSR offsets of each vertex neighbors.
+            const uint32_t *neighbors; // concatenated neighbors lists.
+            const uint32_t *degrees; // optional degree block (NULL if absent).
+            const uint32_t *original_ids; // optional original ids block (NULL if absent).
+
+            // Methods:
+            bool valid_adjacency(Parallel::ThreadPool &pool);
+            template <typename Emit>
+            void visit_range(uint64_t first, uint64_t last, Emit emit);
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline const SnapshotHeader &CsrSnapshot::get_header()
+    {
+        return this->header;
+    }
+
+
+    inline const uint64_t *CsrSnapshot::get_offsets()
+    {
+        return this->offsets;
+    }
+
+
+    inline const uint32_t *CsrSnapshot::get_neighbors()
+    {
+        return this->neighbors;
+    }
+
+
+    inline const uint32_t *CsrSnapshot::get_degrees()
+    {
+        return this->degrees;
+    }
+
+
+    inline const uint32_t *CsrSnapshot::get_original_ids()
+    {
+        return this->original_ids;
+    }
+
+
+    /**
+     ** visit_range():
+     **     params:  first, last -> range of vertices whose lists are read.
+     **              emit -> callable emit(u, v) called once per edge.
+     **
+     **     Emit each undirected edge once from the neighbors lists of the range: an
+     **     edge (u, v) is emitted by u if u < v, a self-loop once every two occurrences.
+     **/
+
+    template <typename Emit>
+    void CsrSnapshot::visit_range(uint64_t first, uint64_t last, Emit emit)
+    {
+        for (uint64_t u = first; u < last; u++)
+        {
+            bool loop_parity = false;
+            for (uint64_t i = this->offsets[u]; i < this->offsets[u + 1]; i++)
+            {
+                uint32_t v = this->neighbors[i];
+                if (v == u)
+                {
+                    loop_parity = !loop_parity;
+                    if (!loop_parity)
+                        continue;
+                }
+                if (v >= u)
+                    emit(u, v);
+            }
+        }
+    }
+
+
+    /**
+     ** visit_edges():
+     **     params:  pool -> threads reading the snapshot.
+     **              visit -> callable visit(u, v) called once per edge.
+     **
+     **     Stream the edges of the snapshot without building an edge list. visit is
+     **     called concurrently from several threads.
+     **/
+
+    template <typename Visitor>
+    void CsrSnapshot::visit_edges(Parallel::ThreadPool &pool, Visitor visit)
+    {
+        uint64_t n = this->header.vertices_nb;
+        size_t ranges_nb = 4 * pool.get_threads_nb();
+
+        pool.run(ranges_nb, [&](size_t t, int)
+        {
+            this->visit_range(Parallel::chunk_begin(n, ranges_nb, t), Parallel::chunk_begin(n, ranges_nb, t + 1),
+                    [&visit](uint64_t u, uint32_t v) { visit(static_cast<uint32_t>(u), v); });
+        });
+    }
+
+
+    /**
+     ** Snapshot useful functions:
+     **/
+
+    bool is_csr_snapshot(std::string filename);
+    void write_csr_snapshot(igraph_t *g, std::string filename, uint32_t flags,
+            const std::vector<uint32_t> *original_ids = NULL, uint32_t original_vertices_nb = 0);
+
+}; // namespace Graph
@@ -4,44 +4,57 @@ namespace Graph
 {
 
     /**
-     ** GraphManager class constructor:
-     **     allocate memory for pointer attributes.
+     ** source_name():
+     **     params: source -> graph version.
+     **
+     **     Name of the graph version in the run report.
      **/
 
-    GraphManager::GraphManager()
+    static std::string source_name(GraphSource source)
     {
-        this->graph = (igraph_t *)malloc(sizeof(igraph_t));
-        if (!(this->graph))
+        switch (source)
         {
-            std::cerr << "Error: malloc can't allocate graph object" << std::endl;
-            exit(1);
+        case GraphSource::GCC:
+            return "gcc";
+        case GraphSource::SUBGRAPH:
+            return "subgraph";
+        case GraphSource::SPANNER:
+            return "spanner";
+        default:
+            return "origin";
         }
+    }
 
-        this->edges = (igraph_vector_t *)malloc(sizeof(igraph_vector_t));
-        if (!(this->edges))
-        {
-            std::cerr << "Error: malloc can't allocate edges object" << std::endl;
-            exit(1);
-        }
 
+    /**
+     ** GraphManager class constructor:
+     **     params: threads_nb -> number of threads of the manager pool, 0 for the number of cores.
+     **
+     **     The igraph structures are created by the loading and computing methods and
+     **     owned by IgraphPtr attributes, released with the manager.
+     **/
+
+    GraphManager::GraphManager(int threads_nb)
+        : pool(threads_nb)
+    {
         this->gcc = NULL;
-        this->span = NULL;
-        this->sub_graph = NULL;
+        this->is_gcc = false;
+        this->low_memory = false;
+        this->original_vertices_nb = 0;
     }
 
 
     /**
      ** GraphManager class destructor:
-     **     free memory for pointer attributes.
+     **     the spanner is released first, then the graphs it was computed from.
      **/
 
     GraphManager::~GraphManager()
     {
-        free(this->graph);
-        free(this->edges);
-
-        if (this->gcc)
-            free(this->gcc);
+        this->span.reset();
+        this->sub_graph.reset();
+        this->gcc_graph.reset();
+        this->graph.reset();
     }
 
 
@@ -50,113 +63,213 @@ namespace Graph
      **     params: filename -> path of graph file.
      **
      **     Read graph from filename file and parse the vertices number
-     **     and edge list.
+     **     and edge list. The file is memory-mapped and its edge section
+     **     is parsed in parallel (see graph_parser.hpp).
      **/
 
     igraph_t *GraphManager::load_graph(std::string filename)
     {
+        Report::ScopedPhase phase("load");
 
         std::cout << "\n\t_______________________________\n\n" << "Loading of the graph from " << filename
             << "...\n";
-        // Open a File pipe to graph filename:
-        FILE *f;
-        if ((f = fopen(filename.c_str(), "r")) == NULL)
+
+        if (is_csr_snapshot(filename))
         {
-            std::cerr << "Error: Impossible to open the graph filename: "
-                << filename
-                << std::endl;
-            exit(1);
+            // Map the binary snapshot and rebuild the edge list from its CSR arrays:
+            CsrSnapshot snapshot(filename, this->pool);
+            this->vertices_nb = snapshot.get_header().vertices_nb;
+            this->edges_nb = snapshot.get_header().edges_nb;
+            this->is_gcc = snapshot.get_header().flags & SNAPSHOT_GCC;
+            this->read_original_ids(snapshot);
+
+            this->edges.resize(this->edges_nb * 2);
+            snapshot.fill_edges(this->edges.get(), this->pool);
         }
+        else
+        {
+            // Map the file and read number of vertices and degree sequence:
+            TextGraphFile file(filename);
+            this->vertices_nb = file.get_vertices_nb();
+            this->edges_nb = file.get_edges_nb();
+            this->original_vertices_nb = this->vertices_nb;
 
-        // Build the graph according to file syntax:
-        char line[MAX_LINE_LENGTH];
-        int *degrees = NULL;
-        int i, u, v;
+            // Read edge list:
+            this->edges.resize(this->edges_nb * 2);
+            igraph_real_t *edges_data = this->edges.data();
 
-        // Read number of vertices:
-        if( fgets(line,MAX_LINE_LENGTH,f) == NULL )
-        {
-            std::cerr << "graph_from_file: read error (fgets) 1" << std::endl;
-            exit(1);
+            file.parse_edges(this->pool, [edges_data](long i, int u, int v)
+            {
+                edges_data[2 * i] = u;
+                edges_data[2 * i + 1] = v;
+            });
         }
-        if( sscanf(line, "%d\n", &(this->vertices_nb)) != 1 )
+
+        // Create the igraph structure:
+        this->graph = create_igraph(this->edges, this->vertices_nb);
+
+        std::cout << "Original graph is composed by:\n"
+            << "\tnumber of vertices: " << igraph_vcount(this->graph.get()) << "\n"
+            << "\tnumber of edges: " << igraph_ecount(this->graph.get()) << "\n"
+            << "Loading done." << std::endl;
+
+        return this->graph.get();
+    }
+
+
+    /**
+     ** load_gcc_low_memory():
+     **     params: filename -> path of graph file (text or CSR snapshot).
+     **             ordering -> relabeling applied to the CSR graph.
+     **             compressed -> build the GCC with compressed neighbors lists.
+     **
+     **     Streaming version of load_graph() + compute_gcc(): the whole graph is never
+     **     stored. A first pass over the mapped file links the edges in a union-find and
+     **     counts the degrees, a second pass writes only the GCC edges into the CSR
+     **     arrays. The GCC is then only available as get_gcc_csr().
+     **
+     **     A compressed GCC is built by ranges of vertices holding COMPRESSED_BUILD_EDGES
+     **     neighbors slots: each range is one more pass over the file, its lists are
+     **     gathered, sorted and encoded, so the plain neighbors array is never whole.
+     **/
+
+    const CsrGraph &GraphManager::load_gcc_low_memory(std::string filename, VertexOrdering ordering, bool compressed)
+    {
+        Report::ScopedPhase phase("load_gcc_low_memory");
+
+        std::cout << "\n\t_______________________________\n\n" << "Streaming the GCC of the graph from "
+            << filename << "...\n";
+
+        std::unique_ptr<CsrSnapshot> snapshot;
+        std::unique_ptr<TextGraphFile> file;
+
+        if (is_csr_snapshot(filename))
         {
-            std::cerr << "graph_from_file: read error (sscanf) 2" << std::endl;
-            exit(1);
+            snapshot.reset(new CsrSnapshot(filename, this->pool));
+            this->vertices_nb = snapshot->get_header().vertices_nb;
+            this->edges_nb = snapshot->get_header().edges_nb;
+            this->read_original_ids(*snapshot);
         }
-
-        // Read the degree sequence:
-        if( (degrees=(int *)malloc(this->vertices_nb*sizeof(int))) == NULL )
+        else
         {
-            std::cerr << "graph_from_file: malloc() error 2" << std::endl;
-            exit(1);
+            file.reset(new TextGraphFile(filename));
+            this->vertices_nb = file->get_vertices_nb();
+            this->edges_nb = file->get_edges_nb();
+            this->original_vertices_nb = this->vertices_nb;
         }
 
-        for(i=0;i<this->vertices_nb;i++){
-            if( fgets(line,MAX_LINE_LENGTH,f) == NULL )
-            {
-                std::cerr << "graph_from_file; read error (fgets) 2" << std::endl;
-                exit(1);
-            }
-            if( sscanf(line, "%d %d\n", &v, &(degrees[i])) != 2 )
-            {
-                std::cerr << "graph_from_file; read error (sscanf) 2" << std::endl;
-                exit(1);
-            }
-            if( v != i ){
-                fprintf(stderr,"Line just read : %s\n i = %d; v = %d\n",line,i,v);
-                std::cerr << "graph_from_file: error while reading degrees" << std::endl;
-                exit(1);
-            }
-        }
+        // visit(u, v) is called once per edge of the file, from several threads:
+        auto stream_edges = [&](auto visit)
+        {
+            if (snapshot)
+                snapshot->visit_edges(this->pool, visit);
+            else
+                file->parse_edges(this->pool, [&visit](long, int u, int v) { visit(u, v); });
+        };
 
-        // Compute the number of edges:
-        this->edges_nb=0;
-        for(i=0;i<this->vertices_nb;i++)
-            this->edges_nb += degrees[i];
-        this->edges_nb /= 2;
+        uint32_t gcc_size = 0;
+        std::vector<uint64_t> offsets;
+        std::vector<uint32_t> neighbors;
+        CompressedAdjacency adjacency;
 
+        {
+            // First pass: components and degrees.
+            std::unique_ptr<std::atomic<uint32_t>[]> degrees(new std::atomic<uint32_t>[this->vertices_nb]);
+            for (int v = 0; v < this->vertices_nb; v++)
+                degrees[v].store(0, std::memory_order_relaxed);
 
-        // Read edge list:
-        igraph_vector_init(this->edges, this->edges_nb * 2);
+            std::vector<uint32_t> original_to_gcc;
 
-        for(i=0;i<this->edges_nb;i++) {
-            if( fgets(line,MAX_LINE_LENGTH,f) == NULL )
             {
-                std::cerr << "graph_from_file; read error (fgets) 3" << std::endl;
-                exit(1);
-            }
-            if( sscanf(line, "%d %d\n", &u, &v) != 2 ){
-                fprintf(stderr,"Attempt to scan link #%d failed. Line read:%s\n", i, line);
-                std::cerr << "graph_from_file; read error (sscanf) 3" << std::endl;
-                exit(1);
+                ConcurrentUnionFind union_find(this->vertices_nb, this->pool);
+
+                stream_edges([&](uint32_t u, uint32_t v)
+                {
+                    union_find.unite(u, v);
+                    degrees[u].fetch_add(1, std::memory_order_relaxed);
+                    degrees[v].fetch_add(1, std::memory_order_relaxed);
+                });
+
+                union_find.compress(this->pool);
+                uint32_t gcc_root = union_find.largest_component(&gcc_size);
+                component_vertices(union_find, gcc_root, this->pool, &this->gcc_vertices, &original_to_gcc);
             }
-            if ( (u>=this->vertices_nb) || (v>=this->vertices_nb) || (u<0) || (v<0) ) {
-                fprintf(stderr,"Line just read: %s",line);
-                std::cerr << "graph_from_file: bad node number" << std::endl;
-                exit(1);
+
+            // Offsets of the GCC vertices, degrees become the filling cursors.
+            offsets.assign(static_cast<size_t>(gcc_size) + 1, 0);
+            for (uint32_t v = 0; v < gcc_size; v++)
+            {
+                offsets[v + 1] = offsets[v] + degrees[this->gcc_vertices[v]].load(std::memory_order_relaxed);
+                degrees[this->gcc_vertices[v]].store(0, std::memory_order_relaxed);
             }
 
-            VECTOR(*(this->edges))[2 * i] = u;
-            VECTOR(*(this->edges))[2 * i + 1] = v;
+            // Second pass: GCC edges only, of the vertices from first to last.
+            auto gather_edges = [&](uint32_t first, uint32_t last)
+            {
+                uint64_t base = offsets[first];
+                neighbors.resize(offsets[last] - base);
+
+                stream_edges([&](uint32_t u, uint32_t v)
+                {
+                    uint32_t gcc_u = original_to_gcc[u];
+                    if (gcc_u == NO_VERTEX)
+                        return;
+
+                    uint32_t gcc_v = original_to_gcc[v];
+                    if (gcc_u >= first && gcc_u < last)
+                        neighbors[offsets[gcc_u] - base + degrees[u].fetch_add(1, std::memory_order_relaxed)] = gcc_v;
+                    if (gcc_v >= first && gcc_v < last)
+                        neighbors[offsets[gcc_v] - base + degrees[v].fetch_add(1, std::memory_order_relaxed)] = gcc_u;
+                });
+            };
+
+            if (!compressed)
+                gather_edges(0, gcc_size);
+
+            for (uint32_t first = 0, last = 0; compressed && first < gcc_size; first = last)
+            {
+                last = first + 1;
+                while (last < gcc_size && offsets[last + 1] - offsets[first] <= COMPRESSED_BUILD_EDGES)
+                    last++;
+
+                gather_edges(first, last);
+
+                // Sort and encode the lists of the range:
+                uint64_t base = offsets[first];
+                size_t chunks_nb = std::min<size_t>(16 * this->pool.get_threads_nb(), last - first);
+                this->pool.run(chunks_nb, [&](size_t chunk, int)
+                {
+                    for (uint32_t v = first + Parallel::chunk_begin(last - first, chunks_nb, chunk);
+                            v < first + Parallel::chunk_begin(last - first, chunks_nb, chunk + 1); v++)
+                        std::sort(neighbors.begin() + (offsets[v] - base), neighbors.begin() + (offsets[v + 1] - base));
+                });
+
+                adjacency.append(first, last, offsets, [&](uint32_t v, uint32_t *)
+                {
+                    return neighbors.data() + (offsets[v] - base);
+                }, this->pool);
+            }
         }
 
-        // Create the igraph structure:
-        igraph_create(this->graph, this->edges, this->vertices_nb, IGRAPH_UNDIRECTED);
-
-        // Check the valid read of the graph file:
-        if( fgets(line,MAX_LINE_LENGTH,f) != NULL )
+        this->map_original_ids(&this->gcc_vertices);
+        if (compressed)
         {
-            std::cerr << "graph_from_file; too many lines" << std::endl;
-            exit(1);
+            std::vector<uint32_t>().swap(neighbors);
+            this->gcc_csr = CsrGraph(gcc_size, std::move(offsets), std::move(adjacency), ordering, this->pool);
         }
+        else
+            this->gcc_csr = CsrGraph(gcc_size, std::move(offsets), std::move(neighbors), ordering);
+        this->low_memory = true;
 
         std::cout << "Original graph is composed by:\n"
-            << "\tnumber of vertices: " << igraph_vcount(this->graph) << "\n"
-            << "\tnumber of edges: " << igraph_ecount(this->graph) << "\n"
-            << "Loading done." << std::endl;
-
-        return this->graph;
+            << "\tnumber of vertices: " << this->vertices_nb << "\n"
+            << "\tnumber of edges: " << this->edges_nb << "\n"
+            << "GCC of the graph is composed by:\n"
+            << "\tnumber of vertices: " << this->gcc_csr.get_vertices_nb() << "\n"
+            << "\tnumber of edges: " << this->gcc_csr.get_edges_nb() << "\n"
+            << "Streaming done." << std::endl;
+
+        return this->gcc_csr;
     }
 
 
@@ -178,15 +291,10 @@ namespace Graph
 
         igraph_vs_seq(&vs, from, to);
 
-        igraph_t *sub_g = (igraph_t *)malloc(sizeof(igraph_t));
-        if (!sub_g)
-        {
-            std::cerr << "Error: malloc failed to allocate sub graph space" << std::endl;
-            exit(1);
-        }
-
-        igraph_induced_subgraph(this->graph, sub_g, vs, IGRAPH_SUBGRAPH_COPY_AND_DELETE);
-        this->sub_graph = sub_g;
+        igraph_t *sub_g = allocate_igraph();
+        igraph_induced_subgraph(this->graph.get(), sub_g, vs, IGRAPH_SUBGRAPH_COPY_AND_DELETE);
+        igraph_vs_destroy(&vs);
+        this->sub_graph.reset(sub_g);
 
         return sub_g;
     }
@@ -197,6 +305,9 @@ namespace Graph
      **     Compute the greatest connected component of the graph.
      **     the objective is to avoid isolated vertices and
      **     obtain a graph with defined excentricity and diameter.
+     **     Components are found in one parallel union-find pass over the
+     **     edge list (see connected_components.hpp), and the GCC vertices
+     **     are numbered compactly in original order (see get_gcc_vertices()).
      **/
 
     igraph_t *GraphManager::compute_gcc()
@@ -204,35 +315,50 @@ namespace Graph
         if (this->gcc)
             return this->gcc;
 
+        // A graph loaded from a GCC snapshot is already connected:
+        if (this->is_gcc)
+        {
+            this->gcc = this->graph.get();
+            this->gcc_vertices.resize(this->vertices_nb);
+            std::iota(this->gcc_vertices.begin(), this->gcc_vertices.end(), 0);
+            this->map_original_ids(&this->gcc_vertices);
+            return this->gcc;
+        }
+
+        Report::ScopedPhase phase("gcc");
 
         std::cout << "\n\t_______________________________\n\n" << "Computing of the GCC ...\n";
 
-        igraph_vector_t components;
-        igraph_vector_t components_size;
-        igraph_vector_init(&components, 1);
-        igraph_vector_init(&components_size, 1);
-        igraph_integer_t nb_components;
+        // Link the extremities of every edge in a shared union-find:
+        const igraph_real_t *edges_data = this->edges.data();
+        size_t edges_nb = igraph_vector_size(this->edges.get()) / 2;
+        size_t chunks_nb = 4 * this->pool.get_threads_nb();
+        ConcurrentUnionFind union_find(this->vertices_nb, this->pool);
 
-        igraph_clusters(this->graph, &components, &components_size, &nb_components, IGRAPH_STRONG);
+        this->pool.run(chunks_nb, [&](size_t chunk, int)
+        {
+            size_t first = Parallel::chunk_begin(edges_nb, chunks_nb, chunk);
+            size_t last = Parallel::chunk_begin(edges_nb, chunks_nb, chunk + 1);
 
-        // get id of max component.
-        int gcc_id = igraph_vector_which_max(&components_size);
+            for (size_t i = first; i < last; i++)
+                union_find.unite(edges_data[2 * i], edges_data[2 * i + 1]);
+        });
 
-        // get a point of the component
-        int gcc_vertex_id = 0;
-        while (VECTOR(components)[gcc_vertex_id] != gcc_id)
-            gcc_vertex_id++;
+        union_find.compress(this->pool);
 
-        // compute GCC graph
-        igraph_vector_t gcc_vertices;
-        igraph_vector_init(&gcc_vertices, 1);
-        igraph_vs_t vs;
+        // Number the vertices of the largest component and gather its edges:
+        uint32_t gcc_size = 0;
+        uint32_t gcc_root = union_find.largest_component(&gcc_size);
+        std::vector<uint32_t> original_to_gcc;
 
-        igraph_subcomponent(this->graph, &gcc_vertices, gcc_vertex_id, IGRAPH_ALL);
-        igraph_vs_vector(&vs, &gcc_vertices);
+        component_vertices(union_find, gcc_root, this->pool, &this->gcc_vertices, &original_to_gcc);
+        this->map_original_ids(&this->gcc_vertices);
 
-        this->gcc = (igraph_t *)malloc(sizeof(igraph_t));
-        igraph_induced_subgraph(this->graph, this->gcc, vs, IGRAPH_SUBGRAPH_COPY_AND_DELETE);
+        IgraphVector gcc_edges;
+        component_edges(edges_data, edges_nb, original_to_gcc, this->pool, gcc_edges.get());
+
+        this->gcc_graph = create_igraph(gcc_edges, gcc_size);
+        this->gcc = this->gcc_graph.get();
 
         std::cout << "GCC of the graph is composed by:\n"
             << "\tnumber of vertices: " << igraph_vcount(this->gcc) << "\n"
@@ -248,31 +374,203 @@ namespace Graph
      **     Compute the graph spanner according to algorithms in spanner_algo.cpp.
      **     A graph spanner in a light version of the graph containing same nulber of edges
      **     but less vertices. The objective is to lighten a graph regarding to the same
-     **     structure.
+     **     structure. After load_gcc_low_memory(), the GCC source is the streamed CSR graph.
+     **     The previous spanner, if any, is released before the new one is computed.
      **/
 
-    igraph_t *GraphManager::compute_spanner(GraphSource source = GraphSource::ORIGIN, Spanner::BFS_STRATEGY strat = Spanner::BFS_STRATEGY::RANDOM, int bfs_nb = 30)
+    igraph_t *GraphManager::compute_spanner(GraphSource source, const Spanner::SpannerParams &params)
     {
+        Report::ScopedPhase phase("spanner");
+
+        this->span.reset();
+
         // Compute span from specific graph version (tests):
         switch(source)
         {
         case GraphSource::ORIGIN:
-            this->span = Spanner::spanner_graph(this->graph, strat, bfs_nb);
+            this->span = Spanner::spanner_graph(this->graph.get(), params, this->pool);
             break;
 
         case GraphSource::GCC:
-            this->span = Spanner::spanner_graph(this->gcc, strat, bfs_nb);
+            if (this->low_memory)
+                this->span = Spanner::spanner_graph(this->gcc_csr, params, this->pool);
+            else
+                this->span = Spanner::spanner_graph(this->gcc, params, this->pool);
             break;
 
         case GraphSource::SUBGRAPH:
-            this->span = Spanner::spanner_graph(this->sub_graph, strat, bfs_nb);
+            this->span = Spanner::spanner_graph(this->sub_graph.get(), params, this->pool);
             break;
 
         default:
             break;
         }
 
-        return this->span;
+        return this->span.get();
+    }
+
+
+    /**
+     ** save_snapshot():
+     **     params: filename -> path of the snapshot file.
+     **             source -> graph version to save (original graph or GCC).
+     **             with_degrees -> add the optional degree block to the snapshot.
+     **
+     **     Write the selected graph as a binary CSR snapshot which can be given
+     **     back to load_graph() instead of the text file. A GCC snapshot keeps the
+     **     original id of each vertex, so its spanner is written in the original ids.
+     **/
+
+    void GraphManager::save_snapshot(std::string filename, GraphSource source, bool with_degrees)
+    {
+        igraph_t *g = (source == GraphSource::GCC) ? this->compute_gcc() : this->graph.get();
+
+        uint32_t flags = with_degrees ? SNAPSHOT_DEGREES : 0;
+        if (source == GraphSource::GCC || this->is_gcc)
+        {
+            flags |= SNAPSHOT_GCC;
+            this->compute_gcc();
+        }
+
+        Report::ScopedPhase phase("snapshot");
+
+        std::cout << "\nWriting CSR snapshot to " << filename << " ..." << std::endl;
+        write_csr_snapshot(g, filename, flags, (flags & SNAPSHOT_GCC) ? &this->gcc_vertices : NULL,
+                this->original_vertices_nb);
+    }
+
+
+    /**
+     ** write_spanner():
+     **     params: filename -> path of the output file.
+     **             format -> DEGREE_LIST, EDGE_LIST or CSR (see graph_writer.hpp).
+     **
+     **     Stream the spanner with the vertex ids of the original graph (the vertices
+     **     outside of the GCC are isolated). compute_spanner() must have been called
+     **     on the GCC.
+     **/
+
+    void GraphManager::write_spanner(std::string filename, OutputFormat format)
+    {
+        Report::ScopedPhase phase("output");
+
+        std::cout << "\nWriting the spanner to " << filename << " ..." << std::endl;
+
+        CsrGraph span_copy;
+        const CsrGraph &span_csr = this->source_csr(GraphSource::SPANNER, &span_copy);
+
+        write_graph(span_csr, this->gcc_vertices, this->original_vertices_nb, filename, format);
+    }
+
+
+    /**
+     ** read_original_ids():
+     **     params: snapshot -> loaded snapshot.
+     **
+     **     Keep the original ids block of the snapshot, if any.
+     **/
+
+    void GraphManager::read_original_ids(CsrSnapshot &snapshot)
+    {
+        uint64_t n = snapshot.get_header().vertices_nb;
+        const uint32_t *ids = snapshot.get_original_ids();
+
+        if (ids)
+        {
+            this->original_ids.assign(ids, ids + n);
+            this->original_vertices_nb = ids[n];
+        }
+        else
+        {
+            this->original_ids.clear();
+            this->original_vertices_nb = n;
+        }
+    }
+
+
+    /**
+     ** map_original_ids():
+     **     params: vertices -> ids of loaded vertices, replaced by their original ids.
+     **/
+
+    void GraphManager::map_original_ids(std::vector<uint32_t> *vertices)
+    {
+        if (this->original_ids.empty())
+            return;
+
+        for (uint32_t &v : *vertices)
+            v = this->original_ids[v];
+    }
+
+
+    /**
+     ** source_csr():
+     **     params: source -> graph version to traverse.
+     **             csr_copy -> storage of the CSR version when it has to be built.
+     **
+     **     Return a CSR version of the selected graph for the traversal based tools.
+     **     The streamed GCC is returned directly, the igraph versions are converted.
+     **/
+
+    const CsrGraph &GraphManager::source_csr(GraphSource source, CsrGraph *csr_copy)
+    {
+        if (source == GraphSource::GCC && this->low_memory)
+            return this->gcc_csr;
+
+        igraph_t *g = this->graph.get();
+        if (source == GraphSource::GCC)
+            g = this->gcc;
+        else if (source == GraphSource::SUBGRAPH)
+            g = this->sub_graph.get();
+        else if (source == GraphSource::SPANNER)
+            g = this->span.get();
+
+        *csr_copy = CsrGraph(g);
+        return *csr_copy;
+    }
+
+
+    /**
+     ** compute_eccentricities():
+     **     params: source -> graph version to study (GCC or spanner, must be connected).
+     **
+     **     Compute the exact eccentricities of the selected graph with the
+     **     bounding eccentricities algorithm (see eccentricities.hpp).
+     **/
+
+    Spanner::EccentricityStats GraphManager::compute_eccentricities(GraphSource source)
+    {
+        Report::ScopedPhase phase("eccentricities_" + source_name(source));
+
+        CsrGraph csr_copy;
+        const CsrGraph &csr = this->source_csr(source, &csr_copy);
+
+        Spanner::BfsEngine engine(csr, this->pool);
+        Spanner::BoundingEccentricities bounding(csr, engine);
+        bounding.run();
+
+        return bounding.stats();
+    }
+
+
+    /**
+     ** evaluate_stretch():
+     **     params: sources_nb -> number of sampled sources.
+     **             seed -> seed of the sources sampling.
+     **
+     **     Compare the spanner distances to the GCC distances from sampled sources
+     **     (see stretch.hpp). compute_spanner() must have been called on the GCC.
+     **/
+
+    Spanner::StretchStats GraphManager::evaluate_stretch(size_t sources_nb, uint64_t seed)
+    {
+        Report::ScopedPhase phase("stretch");
+
+        CsrGraph gcc_copy, span_copy;
+        const CsrGraph &gcc_csr = this->source_csr(GraphSource::GCC, &gcc_copy);
+        const CsrGraph &span_csr = this->source_csr(GraphSource::SPANNER, &span_copy);
+
+        return Spanner::evaluate_stretch(gcc_csr, span_csr, this->pool, sources_nb, seed);
     }
 
 
@@ -290,30 +588,40 @@ namespace Graph
 
 
     /**
-     ** diameter():
-     **     Get the graph diameter according to igraph algorithm.
+     ** compute_diameter():
+     **     params: source -> graph version to study (GCC or spanner, must be connected).
+     **
+     **     Compute the exact diameter of the selected graph and one diametral path
+     **     with the iFUB algorithm (see diameter.hpp).
      **/
 
-    igraph_real_t diameter(igraph_t *g)
+    Spanner::DiameterResult GraphManager::compute_diameter(GraphSource source)
     {
-        igraph_real_t d = 0;
-        igraph_diameter(g, &d, 0, 0, 0, IGRAPH_UNDIRECTED, 1);
+        Report::ScopedPhase phase("diameter_" + source_name(source));
 
-        return d;
+        CsrGraph csr_copy;
+        const CsrGraph &csr = this->source_csr(source, &csr_copy);
+
+        Spanner::BfsEngine engine(csr, this->pool);
+
+        return Spanner::ifub_diameter(csr, engine);
     }
 
 
     /**
-     ** diameter_path():
-     **     Get the graph diameter path according to igraph algorithm.
+     ** diameter():
+     **     params: g -> connected graph.
+     **             pool -> threads running the BFS traversals.
+     **
+     **     Get the graph diameter, one diametral path (igraph ids) and the number
+     **     of BFS done, with the iFUB algorithm on a CSR copy of g.
      **/
 
-    igraph_vector_t diameter_path(igraph_t *g)
+    Spanner::DiameterResult diameter(igraph_t *g, Parallel::ThreadPool &pool)
     {
-        igraph_vector_t path;
-        igraph_vector_init(&path, 10);
-        igraph_diameter(g, 0, 0, 0, &path, IGRAPH_UNDIRECTED, 1);
+        CsrGraph csr(g);
+        Spanner::BfsEngine engine(csr, pool);
 
-        return path;
+        return Spanner::ifub_diameter(csr, engine);
     }
 } // namespace Graph
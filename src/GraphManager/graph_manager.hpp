@@ -4,13 +4,24 @@
 #include <iostream>
 #include <cstdio>
 #include <stdlib.h>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <igraph.h>
 
 #include "spanner_algo.hpp"
-
-
-// Macro used in load_graph() for file parsing:
-#define MAX_LINE_LENGTH 1000
+#include "graph_parser.hpp"
+#include "csr_snapshot.hpp"
+#include "graph_writer.hpp"
+#include "igraph_handle.hpp"
+#include "connected_components.hpp"
+#include "eccentricities.hpp"
+#include "diameter.hpp"
+#include "stretch.hpp"
+#include "thread_pool.hpp"
+#include "run_report.hpp"
 
 
 namespace Graph
@@ -20,7 +31,8 @@ namespace Graph
     {
         ORIGIN,
         GCC,
-        SUBGRAPH
+        SUBGRAPH,
+        SPANNER
     };
 
     /**
@@ -32,31 +44,52 @@ namespace Graph
     {
         public:
 
-            GraphManager();
+            GraphManager(int threads_nb = 0);
             ~GraphManager();
 
             igraph_t *load_graph(std::string filename);
+            const CsrGraph &load_gcc_low_memory(std::string filename, VertexOrdering ordering, bool compressed = false);
             igraph_t *extract_subgraph(int first_vertice, int last_vertices);
             igraph_t *compute_gcc();
-            igraph_t *compute_spanner(GraphSource source, Spanner::BFS_STRATEGY strat, int bfs_nb);
+            igraph_t *compute_spanner(GraphSource source, const Spanner::SpannerParams &params);
+            void save_snapshot(std::string filename, GraphSource source, bool with_degrees);
+            void write_spanner(std::string filename, OutputFormat format);
+            Spanner::EccentricityStats compute_eccentricities(GraphSource source);
+            Spanner::DiameterResult compute_diameter(GraphSource source);
+            Spanner::StretchStats evaluate_stretch(size_t sources_nb, uint64_t seed);
 
             void flush();
 
             // Getters:
             int get_vertices_nb();
             int get_edges_nb();
+            const std::vector<uint32_t> &get_gcc_vertices() const;
+            const CsrGraph &get_gcc_csr() const;
 
 
         private:
 
-            igraph_t *graph; // igraph structure of very large graph.
-            igraph_t *gcc; // Greatest Connected Component of the graph attribute.
-            igraph_t *sub_graph; // sub part of the graph attribute.
-            igraph_t *span; // Spanner version of the graph attribuutes.
-            igraph_vector_t *edges; // all edges of the graph attributes.
+            IgraphPtr graph; // igraph structure of very large graph.
+            IgraphPtr gcc_graph; // GCC computed from graph (empty when graph is already connected).
+            igraph_t *gcc; // Greatest Connected Component of the graph attribute (gcc_graph or graph).
+            IgraphPtr sub_graph; // sub part of the graph attribute.
+            IgraphPtr span; // Spanner version of the graph attribuutes.
+            IgraphVector edges; // all edges of the graph attributes.
+            std::vector<uint32_t> gcc_vertices; // original id of each GCC vertex.
+            std::vector<uint32_t> original_ids; // original id of each loaded vertex (empty if the same).
+            uint32_t original_vertices_nb; // number of vertices of the original graph.
+            CsrGraph gcc_csr; // GCC loaded by load_gcc_low_memory() (igraph structures unused).
+            Parallel::ThreadPool pool; // threads shared by all parallel phases.
 
             int vertices_nb; // number of vertices in graph attributes.
             int edges_nb; // number of edges in graph attributes.
+            bool is_gcc; // true if the loaded graph is known to be connected (GCC snapshot).
+            bool low_memory; // true if the GCC was streamed into gcc_csr only.
+
+            // Methods:
+            const CsrGraph &source_csr(GraphSource source, CsrGraph *csr_copy);
+            void read_original_ids(CsrSnapshot &snapshot);
+            void map_original_ids(std::vector<uint32_t> *vertices);
 
     };
 
@@ -74,11 +107,20 @@ namespace Graph
         return this->edges_nb;
     }
 
+    inline const std::vector<uint32_t> &GraphManager::get_gcc_vertices() const
+    {
+        return this->gcc_vertices;
+    }
+
+    inline const CsrGraph &GraphManager::get_gcc_csr() const
+    {
+        return this->gcc_csr;
+    }
+
     /**
      ** Other graph useful functions:
      **/
 
-    igraph_real_t diameter(igraph_t *g);
-    igraph_vector_t diameter_path(igraph_t *g);
+    Spanner::DiameterResult diameter(igraph_t *g, Parallel::ThreadPool &pool);
 
 }; //namespace Graph
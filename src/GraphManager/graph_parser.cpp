@@ -0,0 +1,219 @@
+#include "graph_parser.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+namespace Graph
+{
+
+    /**
+     ** TextGraphFile class constructor:
+     **     params: filename -> path of graph file.
+     **
+     **     Map the graph file in memory and parse the vertices number and the degree sequence.
+     **/
+
+    TextGraphFile::TextGraphFile(std::string filename)
+        : filename(filename), data(NULL), size(0), edges_begin(NULL), vertices_nb(0), edges_nb(0)
+    {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            std::cerr << "Error: Impossible to open the graph filename: "
+                << filename
+                << std::endl;
+            exit(1);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) < 0 || st.st_size == 0)
+        {
+            std::cerr << "graph_from_file: empty or unreadable file " << filename << std::endl;
+            exit(1);
+        }
+        this->size = st.st_size;
+
+        void *mapped = mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED)
+        {
+            std::cerr << "graph_from_file: mmap() error on " << filename << std::endl;
+            exit(1);
+        }
+        madvise(mapped, this->size, MADV_SEQUENTIAL);
+        this->data = static_cast<const char *>(mapped);
+
+        this->parse_header();
+    }
+
+
+    /**
+     ** TextGraphFile class destructor:
+     **     unmap the graph file.
+     **/
+
+    TextGraphFile::~TextGraphFile()
+    {
+        if (this->data)
+            munmap(const_cast<char *>(this->data), this->size);
+    }
+
+
+    /**
+     ** parse_header():
+     **     Read the number of vertices and the degree sequence, check the vertex ids
+     **     of the degree lines and deduce the number of edges.
+     **/
+
+    void TextGraphFile::parse_header()
+    {
+        const char *end = this->data + this->size;
+        const char *p = this->data;
+        long value;
+
+        // Read number of vertices:
+        if (!parse_int(p, next_line(p, end), value) || value < 0)
+        {
+            std::cerr << "graph_from_file: read error at line 1 (number of vertices)" << std::endl;
+            exit(1);
+        }
+        this->vertices_nb = static_cast<int>(value);
+        p = next_line(p, end);
+
+        // Read the degree sequence:
+        this->degrees.resize(this->vertices_nb);
+        long degrees_sum = 0;
+        long v, degree;
+
+        for (int i = 0; i < this->vertices_nb; i++)
+        {
+            const char *line = p;
+            const char *line_end = next_line(p, end);
+
+            if (p == end || !parse_int(p, line_end, v) || !parse_int(p, line_end, degree))
+            {
+                std::cerr << "graph_from_file: read error at line " << i + 2
+                    << " while reading degrees" << std::endl;
+                exit(1);
+            }
+            if (v != i)
+            {
+                std::cerr << "Line just read: " << std::string(line, line_end - line)
+                    << "i = " << i << "; v = " << v << '\n'
+                    << "graph_from_file: error while reading degrees at line " << i + 2 << std::endl;
+                exit(1);
+            }
+
+            this->degrees[i] = static_cast<int>(degree);
+            degrees_sum += degree;
+            p = line_end;
+        }
+
+        // Compute the number of edges:
+        this->edges_nb = degrees_sum / 2;
+        this->edges_begin = p;
+    }
+
+
+    /**
+     ** split_edge_chunks():
+     **     params:  pool -> threads counting the lines.
+     **
+     **     Split the edge section in chunks beginning on a line start (a few chunks
+     **     per thread to balance the load), count their lines
+     **     in parallel and deduce the index of the first edge of each chunk.
+     **     Check that the edge section contains exactly edges_nb lines.
+     **/
+
+    std::vector<EdgeChunk> TextGraphFile::split_edge_chunks(Parallel::ThreadPool &pool)
+    {
+        const char *end = this->data + this->size;
+        size_t section_size = end - this->edges_begin;
+        int chunks_nb = 4 * pool.get_threads_nb();
+
+        std::vector<EdgeChunk> chunks;
+        const char *chunk_begin = this->edges_begin;
+
+        for (int i = 1; i <= chunks_nb && chunk_begin < end; i++)
+        {
+            const char *chunk_end = (i == chunks_nb) ? end
+                : next_line(this->edges_begin + (section_size / chunks_nb) * i, end);
+
+            if (chunk_end <= chunk_begin)
+                continue;
+
+            chunks.push_back(EdgeChunk{chunk_begin, chunk_end, 0, 0, std::string()});
+            chunk_begin = chunk_end;
+        }
+
+        // Count lines of each chunk:
+        std::vector<long> lines_nb(chunks.size(), 0);
+        pool.run(chunks.size(), [&](size_t i, int)
+        {
+            const char *p = chunks[i].begin;
+            long count = 0;
+
+            while (p < chunks[i].end)
+            {
+                const char *eol = static_cast<const char *>(memchr(p, '\n', chunks[i].end - p));
+                count++;
+                p = eol ? eol + 1 : chunks[i].end;
+            }
+
+            lines_nb[i] = count;
+        });
+
+        long total_lines = 0;
+        for (size_t i = 0; i < chunks.size(); i++)
+        {
+            chunks[i].first_edge = total_lines;
+            total_lines += lines_nb[i];
+        }
+
+        // Check the valid read of the graph file:
+        if (total_lines < this->edges_nb)
+        {
+            std::cerr << "graph_from_file: read error at line " << this->vertices_nb + 2 + total_lines
+                << ", missing edges (" << total_lines << " read, " << this->edges_nb << " expected)" << std::endl;
+            exit(1);
+        }
+        if (total_lines > this->edges_nb)
+        {
+            std::cerr << "graph_from_file: too many lines, line " << this->vertices_nb + 2 + this->edges_nb
+                << " is after the last edge" << std::endl;
+            exit(1);
+        }
+
+        return chunks;
+    }
+
+
+    /**
+     ** check_chunks():
+     **     params:  chunks -> parsed chunks.
+     **
+     **     Report the first parsing error found by the threads, in file order.
+     **/
+
+    void TextGraphFile::check_chunks(std::vector<EdgeChunk> &chunks)
+    {
+        for (EdgeChunk &chunk : chunks)
+        {
+            if (chunk.error_line)
+            {
+                if (chunk.error_msg.empty() || chunk.error_msg.back() != '\n')
+                    chunk.error_msg += '\n';
+
+                std::cerr << "graph_from_file: " << chunk.error_msg
+                    << "graph_from_file: error at line " << chunk.error_line << std::endl;
+                exit(1);
+            }
+        }
+    }
+
+} // namespace Graph
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+
+#include "thread_pool.hpp"
+
+
+namespace Graph
+{
+
+    /**
+     ** EdgeChunk structure:
+     **     Line-aligned part of the edge section parsed by one thread.
+     **     error_line is 0 while no parsing error was found in the chunk.
+     **/
+
+    struct EdgeChunk
+    {
+        const char *begin;
+        const char *end;
+        long first_edge; // index of the first edge line of the chunk.
+
+        long error_line = 0; // line number (1-based) of the first bad line.
+        std::string error_msg;
+    };
+
+
+    /**
+     ** TextGraphFile class:
+     **     Memory-mapped view of a graph file written in the degree/edge-list format:
+     **         <vertices_nb>
+     **         <vertex_id> <degree>     (one line per vertex)
+     **         <u> <v>                  (one line per edge)
+     **     The header and the degree sequence are read sequentially in the constructor,
+     **     then the edge section can be parsed in parallel by line-aligned chunks.
+     **/
+
+    class TextGraphFile
+    {
+        public:
+
+            TextGraphFile(std::string filename);
+            ~TextGraphFile();
+
+            template <typename Visitor>
+            void parse_edges(Parallel::ThreadPool &pool, Visitor visit);
+
+            // Getters:
+            int get_vertices_nb();
+            long get_edges_nb();
+            const std::vector<int> &get_degrees();
+
+        private:
+
+            std::string filename; // path of the mapped graph file.
+            const char *data; // mapped content of the file.
+            size_t size; // size of the mapped content.
+            const char *edges_begin; // first byte of the edge section.
+
+            int vertices_nb; // number of vertices read in header.
+            long edges_nb; // number of edges deduced from the degree sequence.
+            std::vector<int> degrees; // degree sequence of the file.
+
+            // Methods:
+            void parse_header();
+            std::vector<EdgeChunk> split_edge_chunks(Parallel::ThreadPool &pool);
+            void check_chunks(std::vector<EdgeChunk> &chunks);
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline int TextGraphFile::get_vertices_nb()
+    {
+        return this->vertices_nb;
+    }
+
+
+    inline long TextGraphFile::get_edges_nb()
+    {
+        return this->edges_nb;
+    }
+
+
+    inline const std::vector<int> &TextGraphFile::get_degrees()
+    {
+        return this->degrees;
+    }
+
+
+    /**
+     ** parse_int():
+     **     params:  p -> cursor on the text, moved after the parsed integer.
+     **              end -> end of the text.
+     **              value -> parsed value.
+     **
+     **     Hand-written replacement of sscanf("%d"): skip blanks, then read an optionally
+     **     signed decimal integer. Return false if no digit is found before the end of line.
+     **/
+
+    inline bool parse_int(const char *&p, const char *end, long &value)
+    {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            p++;
+
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            negative = (*p == '-');
+            p++;
+        }
+
+        if (p == end || *p < '0' || *p > '9')
+            return false;
+
+        long res = 0;
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            res = res * 10 + (*p - '0');
+            p++;
+        }
+
+        value = negative ? -res : res;
+        return true;
+    }
+
+
+    /**
+     ** next_line():
+     **     Return the first byte after the end of the line pointed by p.
+     **/
+
+    inline const char *next_line(const char *p, const char *end)
+    {
+        while (p < end && *p != '\n')
+            p++;
+
+        return (p < end) ? p + 1 : end;
+    }
+
+
+    /**
+     ** parse_edges():
+     **     params:  pool -> threads parsing the edge section.
+     **              visit -> callable visit(edge_index, u, v) called once per edge line.
+     **
+     **     Parse the edge section of the file by chunks in parallel. visit is called
+     **     concurrently from several threads but never twice with the same edge index.
+     **     Any parsing error stops the program with the line number of the first bad line.
+     **/
+
+    template <typename Visitor>
+    void TextGraphFile::parse_edges(Parallel::ThreadPool &pool, Visitor visit)
+    {
+        std::vector<EdgeChunk> chunks = this->split_edge_chunks(pool);
+        long header_lines = this->vertices_nb + 1;
+        long vertices_nb = this->vertices_nb;
+
+        pool.run(chunks.size(), [&](size_t i, int)
+        {
+            EdgeChunk *chunk = &chunks[i];
+            const char *p = chunk->begin;
+            long edge_index = chunk->first_edge;
+            long u, v;
+
+            while (p < chunk->end)
+            {
+                const char *line = p;
+                if (!parse_int(p, chunk->end, u) || !parse_int(p, chunk->end, v))
+                {
+                    chunk->error_line = header_lines + edge_index + 1;
+                    chunk->error_msg = "read error, attempt to scan link #" + std::to_string(edge_index)
+                        + " failed. Line read: " + std::string(line, next_line(line, chunk->end) - line);
+                    return;
+                }
+                if (u >= vertices_nb || v >= vertices_nb || u < 0 || v < 0)
+                {
+                    chunk->error_line = header_lines + edge_index + 1;
+                    chunk->error_msg = "bad node number. Line read: " + std::string(line, next_line(line, chunk->end) - line);
+                    return;
+                }
+
+                visit(edge_index, static_cast<int>(u), static_cast<int>(v));
+
+                p = next_line(p, chunk->end);
+                edge_index++;
+            }
+        });
+
+        this->check_chunks(chunks);
+    }
+
+}; // namespace Graph
@@ -0,0 +1,219 @@
+#include "graph_writer.hpp"
+#include "csr_snapshot.hpp"
+
+#include <iostream>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace Graph
+{
+
+    /**
+     ** BufferedWriter class constructor:
+     **     params: filename -> path of the output file (created or truncated).
+     **/
+
+    BufferedWriter::BufferedWriter(std::string filename)
+        : filename(filename), buffer(WRITER_BUFFER_SIZE), used(0)
+    {
+        this->fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (this->fd < 0)
+        {
+            std::cerr << "Error: Impossible to open the output filename: " << filename << std::endl;
+            exit(1);
+        }
+    }
+
+
+    /**
+     ** BufferedWriter class destructor:
+     **     write the pending bytes and close the file if close() was not called.
+     **/
+
+    BufferedWriter::~BufferedWriter()
+    {
+        if (this->fd >= 0)
+            this->close();
+    }
+
+
+    /**
+     ** put_bytes():
+     **     params: bytes -> raw bytes written.
+     **             size -> number of bytes.
+     **
+     **     Blocks larger than the buffer are written directly.
+     **/
+
+    void BufferedWriter::put_bytes(const void *bytes, size_t size)
+    {
+        if (this->used + size > this->buffer.size())
+            this->flush();
+
+        if (size >= this->buffer.size())
+        {
+            const char *p = static_cast<const char *>(bytes);
+            while (size > 0)
+            {
+                ssize_t written = write(this->fd, p, size);
+                if (written < 0 && errno == EINTR)
+                    continue;
+                if (written <= 0)
+                {
+                    std::cerr << "Error: write error on output file " << this->filename << std::endl;
+                    exit(1);
+                }
+                p += written;
+                size -= written;
+            }
+            return;
+        }
+
+        memcpy(this->buffer.data() + this->used, bytes, size);
+        this->used += size;
+    }
+
+
+    /**
+     ** flush():
+     **     Write the pending bytes to the file.
+     **/
+
+    void BufferedWriter::flush()
+    {
+        size_t done = 0;
+        while (done < this->used)
+        {
+            ssize_t written = write(this->fd, this->buffer.data() + done, this->used - done);
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+            {
+                std::cerr << "Error: write error on output file " << this->filename << std::endl;
+                exit(1);
+            }
+            done += written;
+        }
+
+        this->used = 0;
+    }
+
+
+    /**
+     ** close():
+     **     Write the pending bytes and close the file, reporting delayed write errors.
+     **/
+
+    void BufferedWriter::close()
+    {
+        this->flush();
+
+        if (::close(this->fd) != 0)
+        {
+            std::cerr << "Error: write error on output file " << this->filename << std::endl;
+            exit(1);
+        }
+        this->fd = -1;
+    }
+
+
+    /**
+     ** write_graph():
+     **     params: graph -> graph to write.
+     **             original_ids -> output id of each vertex of graph (igraph ids of graph).
+     **             original_vertices_nb -> number of vertices of the output numbering.
+     **             filename -> path of the output file.
+     **             format -> DEGREE_LIST, EDGE_LIST or CSR.
+     **
+     **     Stream graph in the output numbering, vertices missing from graph are
+     **     isolated. Vertices are written in output id order, each edge once (from
+     **     both extremities in the CSR neighbors lists).
+     **/
+
+    void write_graph(const CsrGraph &graph, const std::vector<uint32_t> &original_ids, uint32_t original_vertices_nb,
+            std::string filename, OutputFormat format)
+    {
+        // Vertex of graph of each output id:
+        std::vector<uint32_t> vertex_of(original_vertices_nb, NO_VERTEX);
+        for (uint32_t v = 0; v < graph.get_vertices_nb(); v++)
+            vertex_of[original_ids[graph.to_original(v)]] = v;
+
+        auto output_id = [&](uint32_t v) { return original_ids[graph.to_original(v)]; };
+        auto degree = [&](uint32_t o) { return vertex_of[o] == NO_VERTEX ? 0 : graph.degree(vertex_of[o]); };
+
+        BufferedWriter writer(filename);
+        std::vector<uint32_t> buffer(graph.neighbors_buffer_size());
+
+        if (format == OutputFormat::CSR)
+        {
+            SnapshotHeader header;
+            memcpy(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+            header.version = SNAPSHOT_VERSION;
+            header.flags = 0;
+            header.vertices_nb = original_vertices_nb;
+            header.edges_nb = graph.get_edges_nb();
+            writer.put_bytes(&header, sizeof(header));
+
+            uint64_t offset = 0;
+            writer.put_bytes(&offset, sizeof(offset));
+            for (uint32_t o = 0; o < original_vertices_nb; o++)
+            {
+                offset += degree(o);
+                writer.put_bytes(&offset, sizeof(offset));
+            }
+
+            std::vector<uint32_t> neighbors;
+            for (uint32_t o = 0; o < original_vertices_nb; o++)
+            {
+                if (vertex_of[o] == NO_VERTEX)
+                    continue;
+
+                neighbors.clear();
+                const uint32_t *first = graph.neighbors_of(vertex_of[o], buffer.data());
+                for (const uint32_t *it = first; it != first + graph.degree(vertex_of[o]); it++)
+                    neighbors.push_back(output_id(*it));
+                writer.put_bytes(neighbors.data(), neighbors.size() * sizeof(uint32_t));
+            }
+        }
+        else
+        {
+            if (format == OutputFormat::DEGREE_LIST)
+            {
+                writer.put_uint(original_vertices_nb);
+                writer.put_char('\n');
+
+                for (uint32_t o = 0; o < original_vertices_nb; o++)
+                {
+                    writer.put_uint(o);
+                    writer.put_char(' ');
+                    writer.put_uint(degree(o));
+                    writer.put_char('\n');
+                }
+            }
+
+            for (uint32_t o = 0; o < original_vertices_nb; o++)
+            {
+                uint32_t v = vertex_of[o];
+                if (v == NO_VERTEX)
+                    continue;
+
+                const uint32_t *first = graph.neighbors_of(v, buffer.data());
+                for (const uint32_t *it = first; it != first + graph.degree(v); it++)
+                {
+                    if (*it < v)
+                        continue;
+
+                    writer.put_uint(o);
+                    writer.put_char(' ');
+                    writer.put_uint(output_id(*it));
+                    writer.put_char('\n');
+                }
+            }
+        }
+
+        writer.close();
+    }
+
+}; // namespace Graph
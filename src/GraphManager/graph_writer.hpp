@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+
+
+// Size of the output buffer, written with one system call when full:
+#define WRITER_BUFFER_SIZE (8 << 20)
+
+// Longest decimal integer written by put_uint() (UINT64_MAX) plus a separator:
+#define WRITER_MAX_FIELD 21
+
+
+namespace Graph
+{
+
+    /**
+     ** OutputFormat enum:
+     **     Format of a graph written by write_graph().
+     **         DEGREE_LIST -> input text format: vertices number, degree sequence, edges.
+     **         EDGE_LIST -> one "u v" line per edge.
+     **         CSR -> binary CSR snapshot (see csr_snapshot.hpp).
+     **/
+
+    enum OutputFormat
+    {
+        DEGREE_LIST,
+        EDGE_LIST,
+        CSR
+    };
+
+
+    /**
+     ** BufferedWriter class:
+     **     Output file written through a large buffer with write(2), integers are
+     **     formatted by hand two digits at a time (no iostreams, no locale).
+     **/
+
+    class BufferedWriter
+    {
+        public:
+
+            BufferedWriter(std::string filename);
+            ~BufferedWriter();
+
+            void put_uint(uint64_t x);
+            void put_char(char c);
+            void put_bytes(const void *bytes, size_t size);
+            void flush();
+            void close();
+
+        private:
+
+            std::string filename; // path of the output file.
+            int fd; // descriptor of the output file (-1 once closed).
+            std::vector<char> buffer; // pending bytes.
+            size_t used; // number of pending bytes.
+
+    };
+
+
+    /**
+     ** put_uint():
+     **     params:  x -> integer written in decimal.
+     **/
+
+    inline void BufferedWriter::put_uint(uint64_t x)
+    {
+        static const char digit_pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        if (this->used + WRITER_MAX_FIELD > this->buffer.size())
+            this->flush();
+
+        char digits[WRITER_MAX_FIELD];
+        char *first = digits + WRITER_MAX_FIELD;
+
+        while (x >= 100)
+        {
+            first -= 2;
+            memcpy(first, digit_pairs + 2 * (x % 100), 2);
+            x /= 100;
+        }
+
+        if (x >= 10)
+        {
+            first -= 2;
+            memcpy(first, digit_pairs + 2 * x, 2);
+        }
+        else
+            *--first = '0' + x;
+
+        size_t length = digits + WRITER_MAX_FIELD - first;
+        memcpy(this->buffer.data() + this->used, first, length);
+        this->used += length;
+    }
+
+
+    /**
+     ** put_char():
+     **     params:  c -> character written.
+     **/
+
+    inline void BufferedWriter::put_char(char c)
+    {
+        if (this->used == this->buffer.size())
+            this->flush();
+
+        this->buffer[this->used++] = c;
+    }
+
+
+    /**
+     ** Writer useful functions:
+     **/
+
+    void write_graph(const CsrGraph &graph, const std::vector<uint32_t> &original_ids, uint32_t original_vertices_nb,
+            std::string filename, OutputFormat format);
+
+}; // namespace Graph
@@ -0,0 +1,92 @@
+#include "igraph_handle.hpp"
+
+#include <iostream>
+
+
+namespace Graph
+{
+
+    /**
+     ** IgraphDeleter operator():
+     **     params: g -> initialized igraph structure allocated with malloc(), or NULL.
+     **/
+
+    void IgraphDeleter::operator()(igraph_t *g) const
+    {
+        if (!g)
+            return;
+
+        igraph_destroy(g);
+        free(g);
+    }
+
+
+    /**
+     ** IgraphVector class constructor:
+     **     params: size -> initial number of elements (set to 0).
+     **/
+
+    IgraphVector::IgraphVector(long size)
+    {
+        igraph_vector_init(&(this->vector), size);
+    }
+
+
+    /**
+     ** IgraphVector class destructor:
+     **     destroy the igraph vector.
+     **/
+
+    IgraphVector::~IgraphVector()
+    {
+        igraph_vector_destroy(&(this->vector));
+    }
+
+
+    /**
+     ** resize():
+     **     params: size -> new number of elements.
+     **/
+
+    void IgraphVector::resize(long size)
+    {
+        igraph_vector_resize(&(this->vector), size);
+    }
+
+
+    /**
+     ** allocate_igraph():
+     **     Allocate an igraph structure to be initialized by an igraph function
+     **     (igraph_create(), igraph_induced_subgraph() ...), then given to an IgraphPtr.
+     **/
+
+    igraph_t *allocate_igraph()
+    {
+        igraph_t *g = (igraph_t *)malloc(sizeof(igraph_t));
+        if (!g)
+        {
+            std::cerr << "Error: malloc can't allocate graph object" << std::endl;
+            exit(1);
+        }
+
+        return g;
+    }
+
+
+    /**
+     ** create_igraph():
+     **     params: edges -> edge list (u_0, v_0, u_1, v_1, ...).
+     **             vertices_nb -> number of vertices.
+     **
+     **     Create an undirected igraph structure owned by the returned pointer.
+     **/
+
+    IgraphPtr create_igraph(IgraphVector &edges, igraph_integer_t vertices_nb)
+    {
+        igraph_t *g = allocate_igraph();
+        igraph_create(g, edges.get(), vertices_nb, IGRAPH_UNDIRECTED);
+
+        return IgraphPtr(g);
+    }
+
+}; // namespace Graph
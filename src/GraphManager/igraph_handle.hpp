@@ -0,0 +1,82 @@
+#pragma once
+
+#include <memory>
+#include <cstdlib>
+#include <igraph.h>
+
+
+namespace Graph
+{
+
+    /**
+     ** IgraphDeleter structure:
+     **     Release an igraph structure allocated with malloc() and initialized by igraph
+     **     (igraph_create(), igraph_induced_subgraph() ...).
+     **/
+
+    struct IgraphDeleter
+    {
+        void operator()(igraph_t *g) const;
+    };
+
+
+    /**
+     ** IgraphPtr type:
+     **     Owner of an initialized igraph structure, destroyed and freed with it.
+     **/
+
+    typedef std::unique_ptr<igraph_t, IgraphDeleter> IgraphPtr;
+
+
+    /**
+     ** IgraphVector class:
+     **     igraph vector destroyed at the end of its scope.
+     **/
+
+    class IgraphVector
+    {
+        public:
+
+            IgraphVector(long size = 0);
+            ~IgraphVector();
+
+            IgraphVector(const IgraphVector &) = delete;
+            IgraphVector &operator=(const IgraphVector &) = delete;
+
+            void resize(long size);
+
+            // Getters:
+            igraph_vector_t *get();
+            igraph_real_t *data();
+
+        private:
+
+            igraph_vector_t vector; // initialized igraph vector.
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline igraph_vector_t *IgraphVector::get()
+    {
+        return &(this->vector);
+    }
+
+
+    inline igraph_real_t *IgraphVector::data()
+    {
+        return VECTOR(this->vector);
+    }
+
+
+    /**
+     ** igraph handle useful functions:
+     **/
+
+    igraph_t *allocate_igraph();
+    IgraphPtr create_igraph(IgraphVector &edges, igraph_integer_t vertices_nb);
+
+}; // namespace Graph
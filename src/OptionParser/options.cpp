@@ -40,6 +40,53 @@ namespace Option
                 }
             }
 
+            else if (std::string(argv[i]) == "--algorithm")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                algorithm_switch(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--k")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                int k = std::stoi(std::string(argv[i]));
+                if (k < 1)
+                {
+                    std::cerr << "Error: --k must be at least 1" << std::endl;
+                    exit(1);
+                }
+
+                this->spanner_params.k = k;
+            }
+
+            else if (std::string(argv[i]) == "--bs-seed")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->spanner_params.bs_seed = std::stoull(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--degree-threshold")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->spanner_params.degree_threshold = std::stoul(std::string(argv[i]));
+            }
+
             else if (std::string(argv[i]) == "--bfs-strategy")
             {
                 i++;
@@ -57,9 +104,256 @@ namespace Option
                 if (i == argc)
                     print_help();
 
-                this->bfs_nb = std::stoi(std::string(argv[i]));
+                this->spanner_params.bfs_nb = std::stoi(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--threads")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->spanner_params.threads_nb = std::stoi(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--bfs-backend")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                backend_switch(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--do-alpha" || std::string(argv[i]) == "--do-beta")
+            {
+                std::string option = std::string(argv[i]);
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                double threshold = std::stod(std::string(argv[i]));
+                if (threshold <= 0)
+                {
+                    std::cerr << "Error: " << option << " must be positive" << std::endl;
+                    exit(1);
+                }
+
+                if (option == "--do-alpha")
+                    this->spanner_params.do_alpha = threshold;
+                else
+                    this->spanner_params.do_beta = threshold;
+            }
+
+            else if (std::string(argv[i]) == "--representative")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                representative_switch(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--representative-seed")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->spanner_params.representative_seed = std::stoull(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--lp-seed")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->spanner_params.lp_seed = std::stoull(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--lp-threshold")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->spanner_params.lp_threshold = std::stod(std::string(argv[i]));
+                if (this->spanner_params.lp_threshold < 0 || this->spanner_params.lp_threshold > 1)
+                {
+                    std::cerr << "Error: --lp-threshold must be between 0 and 1" << std::endl;
+                    exit(1);
+                }
+            }
+
+            else if (std::string(argv[i]) == "--communities-cache")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->spanner_params.communities_cache = std::string(argv[i]);
+            }
+
+            else if (std::string(argv[i]) == "--bfs-spill")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->spanner_params.bfs_spill = std::string(argv[i]);
+            }
+
+            else if (std::string(argv[i]) == "--incremental")
+                this->spanner_params.incremental = true;
+
+            else if (std::string(argv[i]) == "--max-edges")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->spanner_params.max_edges = std::stoull(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--max-edge-ratio" || std::string(argv[i]) == "--min-gain")
+            {
+                std::string option = std::string(argv[i]);
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                double ratio = std::stod(std::string(argv[i]));
+                if (ratio < 0 || ratio > 1)
+                {
+                    std::cerr << "Error: " << option << " must be between 0 and 1" << std::endl;
+                    exit(1);
+                }
+
+                if (option == "--max-edge-ratio")
+                    this->spanner_params.max_edge_ratio = ratio;
+                else
+                    this->spanner_params.min_gain = ratio;
+            }
+
+            else if (std::string(argv[i]) == "--vertex-order")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                ordering_switch(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--output")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->output_filename = std::string(argv[i]);
+            }
+
+            else if (std::string(argv[i]) == "--output-format")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                output_format_switch(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--snapshot")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->snapshot_filename = std::string(argv[i]);
+            }
+
+            else if (std::string(argv[i]) == "--snapshot-graph")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                if (std::string(argv[i]) == "gcc")
+                    this->snapshot_gcc = true;
+                else if (std::string(argv[i]) == "origin")
+                    this->snapshot_gcc = false;
+                else
+                {
+                    std::cerr << "Error: unrecognize snapshot graph '" << argv[i]
+                        << "'" << std::endl;
+                    exit(1);
+                }
+            }
+
+            else if (std::string(argv[i]) == "--snapshot-degrees")
+                this->snapshot_degrees = true;
+
+            else if (std::string(argv[i]) == "--low-memory")
+                this->low_memory = true;
+
+            else if (std::string(argv[i]) == "--compressed")
+                this->spanner_params.compressed = true;
+
+            else if (std::string(argv[i]) == "--eccentricities")
+                this->eccentricities = true;
+
+            else if (std::string(argv[i]) == "--diameter")
+                this->diameter = true;
+
+            else if (std::string(argv[i]) == "--eval")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->eval_sources_nb = std::stoul(std::string(argv[i]));
             }
 
+            else if (std::string(argv[i]) == "--eval-seed")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->eval_seed = std::stoull(std::string(argv[i]));
+            }
+
+            else if (std::string(argv[i]) == "--report")
+            {
+                i++;
+
+                if (i == argc)
+                    print_help();
+
+                this->report_filename = std::string(argv[i]);
+            }
+
+            else if (std::string(argv[i]) == "--quiet")
+                this->quiet = true;
+
             else if (argv[i][0] == '-')
             {
                 std::cerr << "Error: unrecognize option: " << argv[i] << std::endl;
@@ -72,6 +366,12 @@ namespace Option
             std::cerr << "Error: A filename must be specified with -f" << std::endl;
             exit(1);
         }
+
+        if (this->low_memory && !this->snapshot_filename.empty())
+        {
+            std::cerr << "Error: --snapshot can't be used with --low-memory" << std::endl;
+            exit(1);
+        }
     }
 
 
@@ -80,11 +380,23 @@ namespace Option
     {
         if (strat == "random")
         {
-            this->bfs_strategy = Spanner::BFS_STRATEGY::RANDOM;
+            this->spanner_params.strat = Spanner::BFS_STRATEGY::RANDOM;
         }
         else if (strat == "community")
         {
-            this->bfs_strategy = Spanner::BFS_STRATEGY::COMMUNITY;
+            this->spanner_params.strat = Spanner::BFS_STRATEGY::COMMUNITY;
+        }
+        else if (strat == "label-propagation")
+        {
+            this->spanner_params.strat = Spanner::BFS_STRATEGY::LABEL_PROPAGATION;
+        }
+        else if (strat == "high-degree")
+        {
+            this->spanner_params.strat = Spanner::BFS_STRATEGY::HIGH_DEGREE;
+        }
+        else if (strat == "farthest-point")
+        {
+            this->spanner_params.strat = Spanner::BFS_STRATEGY::FARTHEST_POINT;
         }
         else
         {
@@ -95,17 +407,206 @@ namespace Option
     }
 
 
+    void OptionParser::algorithm_switch(std::string algorithm)
+    {
+        if (algorithm == "bfs-merge")
+        {
+            this->spanner_params.algorithm = Spanner::SPANNER_ALGORITHM::BFS_MERGE;
+        }
+        else if (algorithm == "baswana-sen")
+        {
+            this->spanner_params.algorithm = Spanner::SPANNER_ALGORITHM::BASWANA_SEN;
+        }
+        else if (algorithm == "additive")
+        {
+            this->spanner_params.algorithm = Spanner::SPANNER_ALGORITHM::ADDITIVE_2;
+        }
+        else
+        {
+            std::cerr << "Error: unrecognize spanner algorithm '" << algorithm
+                    << "'" << std::endl;
+            exit(1);
+        }
+    }
+
+
+    void OptionParser::ordering_switch(std::string ordering)
+    {
+        if (ordering == "natural")
+        {
+            this->spanner_params.ordering = Graph::VertexOrdering::NATURAL;
+        }
+        else if (ordering == "degree")
+        {
+            this->spanner_params.ordering = Graph::VertexOrdering::DEGREE;
+        }
+        else if (ordering == "bfs")
+        {
+            this->spanner_params.ordering = Graph::VertexOrdering::BFS;
+        }
+        else
+        {
+            std::cerr << "Error: unrecognize vertex order '" << ordering
+                    << "'" << std::endl;
+            exit(1);
+        }
+    }
+
+
+    void OptionParser::backend_switch(std::string backend)
+    {
+        if (backend == "igraph")
+        {
+            this->spanner_params.bfs_backend = Spanner::BFS_BACKEND::IGRAPH;
+        }
+        else if (backend == "queue")
+        {
+            this->spanner_params.bfs_backend = Spanner::BFS_BACKEND::QUEUE;
+        }
+        else if (backend == "bit-parallel")
+        {
+            this->spanner_params.bfs_backend = Spanner::BFS_BACKEND::BIT_PARALLEL;
+        }
+        else if (backend == "direction-optimizing")
+        {
+            this->spanner_params.bfs_backend = Spanner::BFS_BACKEND::DIRECTION_OPTIMIZING;
+        }
+        else
+        {
+            std::cerr << "Error: unrecognize bfs backend '" << backend
+                    << "'" << std::endl;
+            exit(1);
+        }
+    }
+
+
+    void OptionParser::representative_switch(std::string representative)
+    {
+        if (representative == "degree")
+        {
+            this->spanner_params.representative = Spanner::REPRESENTATIVE::MAX_DEGREE;
+        }
+        else if (representative == "central")
+        {
+            this->spanner_params.representative = Spanner::REPRESENTATIVE::CENTRAL;
+        }
+        else if (representative == "random")
+        {
+            this->spanner_params.representative = Spanner::REPRESENTATIVE::RANDOM_VERTEX;
+        }
+        else
+        {
+            std::cerr << "Error: unrecognize community representative '" << representative
+                    << "'" << std::endl;
+            exit(1);
+        }
+    }
+
+
+    void OptionParser::output_format_switch(std::string format)
+    {
+        if (format == "degree")
+        {
+            this->output_format = Graph::OutputFormat::DEGREE_LIST;
+        }
+        else if (format == "edges")
+        {
+            this->output_format = Graph::OutputFormat::EDGE_LIST;
+        }
+        else if (format == "csr")
+        {
+            this->output_format = Graph::OutputFormat::CSR;
+        }
+        else
+        {
+            std::cerr << "Error: unrecognize output format '" << format
+                    << "'" << std::endl;
+            exit(1);
+        }
+    }
+
+
     void print_help()
     {
         std::cout << "usage: ./vls <-f <graph_filename> > [-h/--help] [-S] [-D] [--bfs-strategy <strategy>]\n\n"
             << "Options description:\n" << "-f <graph_filename>:\t\tspecify the graph filename location.\n"
             << "-S:\t\t\t\tShow spanner graph in a human-readable way.\n"
             << "-D:\t\t\t\tPrint debug information during processing.\n"
+            << "--algorithm <algorithm>:\tspanner construction.\n"
+            << "\tPossible algorithms:\n"
+            << "\t\tbfs-merge:\tunion of BFS trees from selected sources (default)\n"
+            << "\t\tbaswana-sen:\trandomized clustering (2k-1)-spanner, without BFS\n"
+            << "\t\tadditive:\t+2 spanner: low degree vertex edges and BFS trees from the centers\n"
+            << "\t\t\t\tof clusters dominating the high degree vertices (evaluated by --eval,\n"
+            << "\t\t\t\t16 sources by default). Keeps the whole GCC when no vertex reaches\n"
+            << "\t\t\t\t--degree-threshold (sqrt(n) by default, too high for sparse graphs)\n"
+            << "--k <k>:\t\t\tstretch parameter of baswana-sen (default: 2).\n"
+            << "--bs-seed <seed>:\t\tseed of the baswana-sen cluster sampling (default: 42).\n"
+            << "--degree-threshold <d>:\t\tdegree of the high degree vertices of additive (default: sqrt(n)).\n"
             << "--bfs-strategy <strategy>:\tspecify the source selection BFS strategy for spanner computing.\n"
             << "\tPossible strategies:\n"
             << "\t\trandom:\t\tselect some source points randomly\n"
             << "\t\tcommunity:\tselect one source point by community in graph\n"
-            << "--bfs-number <nb>:\t\tspecify the number of BFS to do during spanner computing."
+            << "\t\tlabel-propagation:\tsame with communities found by parallel label propagation\n"
+            << "\t\thigh-degree:\tselect the highest degree vertices\n"
+            << "\t\tfarthest-point:\teach source is the vertex farthest from the previous ones (k-center)\n"
+            << "--representative <choice>:\tBFS source of each community (community strategy), one source\n"
+            << "\t\t\t\tper community from the largest one.\n"
+            << "\tPossible choices:\n"
+            << "\t\tdegree:\t\thighest degree vertex (default)\n"
+            << "\t\tcentral:\tapproximate center found by a BFS inside the community\n"
+            << "\t\trandom:\t\trandom vertex\n"
+            << "--representative-seed <seed>:\tseed of the random representatives (default: 42).\n"
+            << "--lp-seed <seed>:\t\tseed of the label propagation (default: 42).\n"
+            << "--lp-threshold <t>:\t\tlabel propagation stops when less than this fraction of the\n"
+            << "\t\t\t\tlabels change in an iteration (default: 0.001).\n"
+            << "--communities-cache <file>:\tread the Leiden communities from file, or compute and save them.\n"
+            << "--bfs-number <nb>:\t\tspecify the number of BFS to do during spanner computing.\n"
+            << "--threads <nb>:\t\t\tnumber of threads used for loading and BFS (default: number of cores).\n"
+            << "--bfs-backend <backend>:\tspecify the BFS implementation used for spanner computing.\n"
+            << "\tPossible backends:\n"
+            << "\t\tigraph:\t\tone igraph BFS per source\n"
+            << "\t\tqueue:\t\tone CSR BFS per source, sources in parallel (default)\n"
+            << "\t\tbit-parallel:\t64 sources advanced together in one traversal\n"
+            << "\t\tdirection-optimizing:\ttop-down/bottom-up switching BFS per source\n"
+            << "--do-alpha <a>, --do-beta <b>:\tdirection-optimizing switching thresholds (default 14 and 24).\n"
+            << "--incremental:\t\t\tcompute the BFS by batches while the spanner grows, instead of all\n"
+            << "\t\t\t\tof them before merging, and print the gain and estimated stretch.\n"
+            << "--max-edges <nb>:\t\tstop merging BFS trees before the spanner exceeds nb edges.\n"
+            << "--max-edge-ratio <r>:\t\tsame as a fraction of the GCC edges (default: 0.8).\n"
+            << "--min-gain <g>:\t\t\tstop merging when less than this fraction of a tree is new\n"
+            << "\t\t\t\tedges (default: 0).\n"
+            << "--bfs-spill <file>:\t\tallocate all the BFS results of the run in a memory mapped\n"
+            << "\t\t\t\tscratch file (deleted at exit) instead of the heap, the regions\n"
+            << "\t\t\t\tof released results being reused.\n"
+            << "--vertex-order <order>:\t\tvertex relabeling of the CSR graph used by BFS.\n"
+            << "\tPossible orders:\n"
+            << "\t\tnatural:\tkeep the graph ids (default)\n"
+            << "\t\tdegree:\t\tsort vertices by decreasing degree\n"
+            << "\t\tbfs:\t\tnumber vertices in BFS order\n"
+            << "--output <file>:\t\twrite the spanner with the vertex ids of the input graph.\n"
+            << "--output-format <format>:\tformat of the --output file.\n"
+            << "\tPossible formats:\n"
+            << "\t\tdegree:\t\tvertices number, degree sequence and edges, as the input (default)\n"
+            << "\t\tedges:\t\tone \"u v\" line per edge\n"
+            << "\t\tcsr:\t\tbinary CSR snapshot, which can be given back to -f\n"
+            << "--snapshot <file>:\t\twrite the graph as a binary CSR snapshot, which can be given back to -f.\n"
+            << "--snapshot-graph <graph>:\tgraph saved by --snapshot: 'gcc' (default) or 'origin'.\n"
+            << "--snapshot-degrees:\t\tadd the degree block to the snapshot.\n"
+            << "--low-memory:\t\t\tstream the GCC of the file into a compact CSR graph, without\n"
+            << "\t\t\t\tigraph copies of the whole graph (two passes over the file).\n"
+            << "--compressed:\t\t\tstore the neighbors lists of the CSR graph as gaps in stream-VByte\n"
+            << "\t\t\t\t(the gain depends on the locality of the ids, see --vertex-order),\n"
+            << "\t\t\t\tdecoded by the traversals. With --low-memory, the GCC is built\n"
+            << "\t\t\t\tcompressed by vertex ranges.\n"
+            << "--eccentricities:\t\tcompute the exact eccentricities of the GCC and of the spanner\n"
+            << "\t\t\t\t(bounding eccentricities algorithm) and print their distributions.\n"
+            << "--diameter:\t\t\tcompute the exact diameter of the GCC and of the spanner (iFUB).\n"
+            << "--eval <K>:\t\t\tcompare spanner and GCC distances from K sampled sources (stretch).\n"
+            << "--eval-seed <seed>:\t\tseed of the --eval sources sampling (default: 42).\n"
+            << "--report <file>:\t\twrite the time, CPU, memory, traversed edges and BFS count\n"
+            << "\t\t\t\tof each phase as a JSON report.\n"
+            << "--quiet:\t\t\tdo not print the progress messages of each BFS and merge."
             << std::endl;
 
         exit(0);
@@ -5,6 +5,7 @@
 #include <filesystem>
 
 #include "spanner_algo.hpp"
+#include "graph_writer.hpp"
 
 
 namespace Option
@@ -24,6 +25,19 @@ namespace Option
             std::string get_filename();
             Spanner::BFS_STRATEGY get_bfs_strategy();
             int get_bfs_nb();
+            const Spanner::SpannerParams &get_spanner_params();
+            std::string get_snapshot_filename();
+            bool get_snapshot_gcc();
+            bool get_snapshot_degrees();
+            bool get_low_memory();
+            bool get_eccentricities();
+            bool get_diameter();
+            size_t get_eval_sources_nb();
+            uint64_t get_eval_seed();
+            std::string get_report_filename();
+            bool get_quiet();
+            std::string get_output_filename();
+            Graph::OutputFormat get_output_format();
 
         private:
 
@@ -31,11 +45,27 @@ namespace Option
             std::string filename; // graph filename to load.
             bool show_graph = false; // option to print graph during processing.
             bool debug = false; // option to print debug information during processing.
-            Spanner::BFS_STRATEGY bfs_strategy = Spanner::BFS_STRATEGY::RANDOM;
-            int bfs_nb = 50;
+            Spanner::SpannerParams spanner_params; // BFS strategy, BFS number, CSR ordering ...
+            std::string snapshot_filename; // binary CSR snapshot to write (empty for none).
+            bool snapshot_gcc = true; // save the GCC (true) or the original graph (false).
+            bool snapshot_degrees = false; // add the degree block to the snapshot.
+            bool low_memory = false; // stream the GCC into a CSR graph without the igraph copies.
+            bool eccentricities = false; // compare the GCC and spanner eccentricities.
+            bool diameter = false; // compare the GCC and spanner exact diameters.
+            size_t eval_sources_nb = 0; // number of sources of the stretch evaluation (0 for none).
+            uint64_t eval_seed = RNG_SEED; // seed of the stretch evaluation sources.
+            std::string report_filename; // JSON run report to write (empty for none).
+            bool quiet = false; // drop the per-BFS progress messages.
+            std::string output_filename; // spanner file to write (empty for none).
+            Graph::OutputFormat output_format = Graph::OutputFormat::DEGREE_LIST; // format of the spanner file.
 
             // Methods:
+            void algorithm_switch(std::string algorithm);
             void strategy_switch(std::string strat);
+            void ordering_switch(std::string ordering);
+            void backend_switch(std::string backend);
+            void representative_switch(std::string representative);
+            void output_format_switch(std::string format);
 
     };
 
@@ -52,13 +82,91 @@ namespace Option
 
     inline Spanner::BFS_STRATEGY OptionParser::get_bfs_strategy()
     {
-        return this->bfs_strategy;
+        return this->spanner_params.strat;
     }
 
 
     inline int OptionParser::get_bfs_nb()
     {
-        return this->bfs_nb;
+        return this->spanner_params.bfs_nb;
+    }
+
+
+    inline const Spanner::SpannerParams &OptionParser::get_spanner_params()
+    {
+        return this->spanner_params;
+    }
+
+
+    inline std::string OptionParser::get_snapshot_filename()
+    {
+        return this->snapshot_filename;
+    }
+
+
+    inline bool OptionParser::get_snapshot_gcc()
+    {
+        return this->snapshot_gcc;
+    }
+
+
+    inline bool OptionParser::get_snapshot_degrees()
+    {
+        return this->snapshot_degrees;
+    }
+
+
+    inline bool OptionParser::get_low_memory()
+    {
+        return this->low_memory;
+    }
+
+
+    inline bool OptionParser::get_eccentricities()
+    {
+        return this->eccentricities;
+    }
+
+
+    inline bool OptionParser::get_diameter()
+    {
+        return this->diameter;
+    }
+
+
+    inline size_t OptionParser::get_eval_sources_nb()
+    {
+        return this->eval_sources_nb;
+    }
+
+
+    inline uint64_t OptionParser::get_eval_seed()
+    {
+        return this->eval_seed;
+    }
+
+
+    inline std::string OptionParser::get_report_filename()
+    {
+        return this->report_filename;
+    }
+
+
+    inline bool OptionParser::get_quiet()
+    {
+        return this->quiet;
+    }
+
+
+    inline std::string OptionParser::get_output_filename()
+    {
+        return this->output_filename;
+    }
+
+
+    inline Graph::OutputFormat OptionParser::get_output_format()
+    {
+        return this->output_format;
     }
 
 
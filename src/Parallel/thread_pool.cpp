@@ -0,0 +1,135 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+
+namespace Parallel
+{
+
+    /**
+     ** ThreadPool class constructor:
+     **     params: threads_nb -> number of threads used by run(), including the
+     **                           calling thread. 0 or less selects the number of cores.
+     **/
+
+    ThreadPool::ThreadPool(int threads_nb)
+        : job(NULL), tasks_nb(0), next_task(0), active_workers(0), generation(0), stop(false)
+    {
+        if (threads_nb <= 0)
+            threads_nb = std::max(1u, std::thread::hardware_concurrency());
+
+        for (int i = 1; i < threads_nb; i++)
+            this->workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+
+
+    /**
+     ** ThreadPool class destructor:
+     **     wake up and join all workers.
+     **/
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stop = true;
+        }
+        this->wake_cond.notify_all();
+
+        for (std::thread &worker : this->workers)
+            worker.join();
+    }
+
+
+    /**
+     ** run():
+     **     params:  tasks_nb -> number of tasks to process.
+     **              job -> callable job(task, thread_id) processing one task, thread_id
+     **                     is in [0, threads_nb) and can index per-thread buffers.
+     **
+     **     Process all tasks on the pool threads and return when they are all done.
+     **/
+
+    void ThreadPool::run(size_t tasks_nb, const std::function<void(size_t task, int thread_id)> &job)
+    {
+        if (tasks_nb == 0)
+            return;
+
+        if (this->workers.empty() || tasks_nb == 1)
+        {
+            for (size_t task = 0; task < tasks_nb; task++)
+                job(task, 0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->job = &job;
+            this->tasks_nb = tasks_nb;
+            this->next_task = 0;
+            this->active_workers = this->workers.size();
+            this->generation++;
+        }
+        this->wake_cond.notify_all();
+
+        this->process_tasks(0);
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->done_cond.wait(lock, [this] { return this->active_workers == 0; });
+        this->job = NULL;
+    }
+
+
+    /**
+     ** worker_loop():
+     **     params:  thread_id -> id of the worker thread.
+     **
+     **     Wait for new jobs and process their tasks until the pool is destroyed.
+     **/
+
+    void ThreadPool::worker_loop(int thread_id)
+    {
+        uint64_t seen_generation = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->wake_cond.wait(lock, [this, seen_generation]
+                {
+                    return this->stop || this->generation != seen_generation;
+                });
+
+                if (this->stop)
+                    return;
+
+                seen_generation = this->generation;
+            }
+
+            this->process_tasks(thread_id);
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->active_workers--;
+            }
+            this->done_cond.notify_one();
+        }
+    }
+
+
+    /**
+     ** process_tasks():
+     **     params:  thread_id -> id of the running thread.
+     **
+     **     Take tasks of the current job one by one until none is left.
+     **/
+
+    void ThreadPool::process_tasks(int thread_id)
+    {
+        size_t task;
+
+        while ((task = this->next_task.fetch_add(1)) < this->tasks_nb)
+            (*(this->job))(task, thread_id);
+    }
+
+} // namespace Parallel
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include <cstdint>
+
+
+namespace Parallel
+{
+
+    /**
+     ** ThreadPool class:
+     **     Fixed set of worker threads created once and reused by every parallel phase
+     **     (graph loading, BFS, components ...). run() distributes tasks dynamically
+     **     and blocks until all of them are done, the calling thread works as thread 0.
+     **     Calls to run() must not be nested.
+     **/
+
+    class ThreadPool
+    {
+        public:
+
+            ThreadPool(int threads_nb = 0);
+            ~ThreadPool();
+
+            void run(size_t tasks_nb, const std::function<void(size_t task, int thread_id)> &job);
+
+            // Getters:
+            int get_threads_nb() const;
+
+        private:
+
+            std::vector<std::thread> workers; // threads 1 to threads_nb - 1.
+            std::mutex mutex;
+            std::condition_variable wake_cond; // signaled when a new job is available.
+            std::condition_variable done_cond; // signaled when a worker ends the current job.
+
+            const std::function<void(size_t, int)> *job; // current job.
+            size_t tasks_nb; // number of tasks of the current job.
+            std::atomic<size_t> next_task; // next task index to process.
+            int active_workers; // workers still running the current job.
+            uint64_t generation; // incremented for each new job.
+            bool stop; // set by the destructor.
+
+            // Methods:
+            void worker_loop(int thread_id);
+            void process_tasks(int thread_id);
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline int ThreadPool::get_threads_nb() const
+    {
+        return this->workers.size() + 1;
+    }
+
+
+    /**
+     ** chunk_begin():
+     **     params:  size -> number of elements to split.
+     **              chunks_nb -> number of chunks.
+     **              chunk -> chunk index (chunks_nb gives the end of the last chunk).
+     **
+     **     Return the first element of a chunk when size elements are split into
+     **     chunks_nb contiguous chunks of almost equal size.
+     **/
+
+    inline size_t chunk_begin(size_t size, size_t chunks_nb, size_t chunk)
+    {
+        return static_cast<size_t>((static_cast<unsigned __int128>(size) * chunk) / chunks_nb);
+    }
+
+} // namespace Parallel
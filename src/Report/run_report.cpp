@@ -0,0 +1,198 @@
+#include "run_report.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <malloc.h>
+#include <sys/resource.h>
+
+
+namespace Report
+{
+
+    std::atomic<uint64_t> edges_counter(0);
+    std::atomic<uint64_t> bfs_counter(0);
+
+    static std::vector<PhaseStats> phases; // recorded phases, in starting order.
+    static int open_phases_nb = 0; // number of phases currently measured.
+    static bool quiet_mode = false; // drop the progress messages of each BFS.
+
+
+    /**
+     ** cpu_time():
+     **     Return the user + system time consumed by all the threads of the process.
+     **/
+
+    static double cpu_time()
+    {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+            + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+
+
+    /**
+     ** heap_in_use():
+     **     Return the bytes allocated by malloc and not freed (arena and mmapped chunks).
+     **     mallinfo2() only exists since glibc 2.33, 0 is returned before.
+     **/
+
+    static int64_t heap_in_use()
+    {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+        struct mallinfo2 info = mallinfo2();
+        return info.uordblks + info.hblkhd;
+#else
+        return 0;
+#endif
+    }
+
+
+    /**
+     ** ScopedPhase class constructor:
+     **     params: name -> name of the phase in the report.
+     **/
+
+    ScopedPhase::ScopedPhase(std::string name)
+        : index(phases.size()), start(std::chrono::steady_clock::now()), cpu_start(cpu_time()),
+        heap_start(heap_in_use()), edges_start(edges_counter.load(std::memory_order_relaxed)),
+        bfs_start(bfs_counter.load(std::memory_order_relaxed)), stopped(false)
+    {
+        PhaseStats stats;
+        stats.name = name;
+        stats.depth = open_phases_nb++;
+
+        phases.push_back(stats);
+    }
+
+
+    /**
+     ** ScopedPhase class destructor:
+     **     record the measures of the phase if stop() was not called.
+     **/
+
+    ScopedPhase::~ScopedPhase()
+    {
+        this->stop();
+    }
+
+
+    /**
+     ** stop():
+     **     End the phase before the end of the scope and record its measures.
+     **/
+
+    void ScopedPhase::stop()
+    {
+        if (this->stopped)
+            return;
+
+        this->stopped = true;
+        std::chrono::duration<double> wall = std::chrono::steady_clock::now() - this->start;
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        PhaseStats &stats = phases[this->index];
+        stats.wall_s = wall.count();
+        stats.cpu_s = cpu_time() - this->cpu_start;
+        stats.allocated_bytes = heap_in_use() - this->heap_start;
+        stats.edges_traversed = edges_counter.load(std::memory_order_relaxed) - this->edges_start;
+        stats.bfs_nb = bfs_counter.load(std::memory_order_relaxed) - this->bfs_start;
+        stats.peak_rss_kb = usage.ru_maxrss;
+
+        open_phases_nb--;
+    }
+
+
+    /**
+     ** set_quiet(), is_quiet():
+     **     Quiet mode drops the messages printed for each BFS and each merge.
+     **/
+
+    void set_quiet(bool quiet)
+    {
+        quiet_mode = quiet;
+    }
+
+
+    bool is_quiet()
+    {
+        return quiet_mode;
+    }
+
+
+    const std::vector<PhaseStats> &get_phases()
+    {
+        return phases;
+    }
+
+
+    /**
+     ** json_string():
+     **     params: str -> text to write as a JSON string.
+     **
+     **     Return str quoted, with quotes, backslashes and control characters escaped.
+     **/
+
+    static std::string json_string(const std::string &str)
+    {
+        std::string res = "\"";
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+                res += '\\';
+
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char code[8];
+                snprintf(code, sizeof(code), "\\u%04x", c);
+                res += code;
+            }
+            else
+                res += c;
+        }
+
+        return res + '"';
+    }
+
+
+    /**
+     ** write_json():
+     **     params: filename -> path of the report file.
+     **             run_info -> (key, value) description of the run (input, options ...),
+     **                         values are written as JSON strings.
+     **
+     **     Write the run description and the measures of all the phases.
+     **/
+
+    void write_json(std::string filename, const std::vector<std::pair<std::string, std::string>> &run_info)
+    {
+        std::ofstream out(filename);
+        if (!out)
+        {
+            std::cerr << "Error: can't write the report file " << filename << std::endl;
+            exit(1);
+        }
+
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        out << "{\n  \"run\": {";
+        for (size_t i = 0; i < run_info.size(); i++)
+            out << (i ? ", " : "") << json_string(run_info[i].first) << ": " << json_string(run_info[i].second);
+
+        out << "},\n  \"peak_rss_kb\": " << usage.ru_maxrss << ",\n  \"phases\": [\n";
+        for (size_t i = 0; i < phases.size(); i++)
+        {
+            const PhaseStats &p = phases[i];
+            out << "    {\"name\": " << json_string(p.name) << ", \"depth\": " << p.depth << ", \"wall_s\": " << p.wall_s
+                << ", \"cpu_s\": " << p.cpu_s << ", \"allocated_bytes\": " << p.allocated_bytes
+                << ", \"edges_traversed\": " << p.edges_traversed << ", \"bfs_nb\": " << p.bfs_nb
+                << ", \"peak_rss_kb\": " << p.peak_rss_kb << "}" << (i + 1 < phases.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}" << std::endl;
+    }
+
+} // namespace Report
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+
+
+namespace Report
+{
+
+    /**
+     ** PhaseStats structure:
+     **     Measures of one instrumented phase of a run.
+     **/
+
+    struct PhaseStats
+    {
+        std::string name; // phase name.
+        int depth = 0; // nesting level of the phase (0 for a top-level phase).
+        double wall_s = 0.0; // wall time in seconds.
+        double cpu_s = 0.0; // user + system time of all the threads in seconds.
+        int64_t allocated_bytes = 0; // growth of the heap in use during the phase.
+        uint64_t edges_traversed = 0; // adjacency entries read by the traversals.
+        uint64_t bfs_nb = 0; // number of BFS traversals.
+        long peak_rss_kb = 0; // peak resident memory of the process at the end of the phase.
+    };
+
+
+    /**
+     ** ScopedPhase class:
+     **     Measure the enclosing scope as a phase: the constructor takes the start
+     **     time and counters, the destructor (or an earlier stop()) records the
+     **     differences. Phases are opened from the main thread and may be nested,
+     **     the counters are updated from any thread.
+     **/
+
+    class ScopedPhase
+    {
+        public:
+
+            ScopedPhase(std::string name);
+            ~ScopedPhase();
+
+            void stop();
+
+        private:
+
+            size_t index; // position of the phase in the recorded phases.
+            std::chrono::steady_clock::time_point start; // wall time at the start.
+            double cpu_start; // process CPU time at the start.
+            int64_t heap_start; // heap in use at the start.
+            uint64_t edges_start; // traversed edges counter at the start.
+            uint64_t bfs_start; // BFS counter at the start.
+            bool stopped; // true once the measures are recorded.
+
+    };
+
+
+    /**
+     ** Counters and report functions:
+     **/
+
+    extern std::atomic<uint64_t> edges_counter; // adjacency entries read since the start.
+    extern std::atomic<uint64_t> bfs_counter; // BFS traversals done since the start.
+
+    inline void count_edges(uint64_t edges_nb)
+    {
+        edges_counter.fetch_add(edges_nb, std::memory_order_relaxed);
+    }
+
+
+    inline void count_bfs(uint64_t bfs_nb = 1)
+    {
+        bfs_counter.fetch_add(bfs_nb, std::memory_order_relaxed);
+    }
+
+
+    void set_quiet(bool quiet);
+    bool is_quiet();
+    const std::vector<PhaseStats> &get_phases();
+    void write_json(std::string filename, const std::vector<std::pair<std::string, std::string>> &run_info);
+
+} // namespace Report
@@ -0,0 +1,101 @@
+#include "additive_spanner.hpp"
+#include "run_report.hpp"
+
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+
+namespace Spanner
+{
+
+    /**
+     ** heavy_degree_threshold():
+     **     params:  csr -> graph to span.
+     **              threshold -> degree asked by the user, 0 for the default one.
+     **
+     **     Return the degree from which a vertex is heavy, ceil(sqrt(n)) by default:
+     **     it balances the light edges (less than n * threshold) and the BFS trees of
+     **     the centers (about n / threshold trees of n - 1 edges).
+     **/
+
+    uint32_t heavy_degree_threshold(const Graph::CsrGraph &csr, uint32_t threshold)
+    {
+        if (threshold > 0)
+            return threshold;
+
+        return std::max<uint32_t>(std::ceil(std::sqrt(static_cast<double>(csr.get_vertices_nb()))), 1);
+    }
+
+
+    /**
+     ** add_light_edges():
+     **     params:  csr -> graph to span.
+     **              threshold -> degree from which a vertex is heavy.
+     **              span_edges -> accumulator receiving the spanner edges.
+     **
+     **     Keep every edge with a light extremity. Return the number of added edges.
+     **/
+
+    size_t add_light_edges(const Graph::CsrGraph &csr, uint32_t threshold, EdgeAccumulator *span_edges)
+    {
+        size_t added_nb = 0;
+        std::vector<uint32_t> buffer(csr.neighbors_buffer_size());
+
+        for (uint32_t v = 0; v < csr.get_vertices_nb(); v++)
+        {
+            const uint32_t *first = csr.neighbors_of(v, buffer.data());
+            for (const uint32_t *it = first; it != first + csr.degree(v); it++)
+                if (v < *it && (csr.degree(v) < threshold || csr.degree(*it) < threshold))
+                    added_nb += span_edges->add_edge(v, *it);
+        }
+
+        Report::count_edges(csr.get_edges_nb());
+
+        return added_nb;
+    }
+
+
+    /**
+     ** dominating_centers():
+     **     params:  csr -> graph to span.
+     **              threshold -> degree from which a vertex is heavy.
+     **
+     **     Greedy dominating set of the heavy vertices: they are visited by decreasing
+     **     degree, and a heavy vertex not yet adjacent to a center becomes one. Each
+     **     center and its neighbors form a cluster covering at least threshold + 1
+     **     vertices, hubs first so the clusters are large.
+     **/
+
+    std::vector<uint32_t> dominating_centers(const Graph::CsrGraph &csr, uint32_t threshold)
+    {
+        std::vector<uint32_t> heavy;
+        for (uint32_t v = 0; v < csr.get_vertices_nb(); v++)
+            if (csr.degree(v) >= threshold)
+                heavy.push_back(v);
+
+        std::stable_sort(heavy.begin(), heavy.end(), [&csr](uint32_t a, uint32_t b)
+        {
+            return csr.degree(a) > csr.degree(b);
+        });
+
+        std::vector<bool> dominated(csr.get_vertices_nb(), false);
+        std::vector<uint32_t> centers;
+        std::vector<uint32_t> buffer(csr.neighbors_buffer_size());
+
+        for (uint32_t v : heavy)
+        {
+            if (dominated[v])
+                continue;
+
+            centers.push_back(v);
+            dominated[v] = true;
+            const uint32_t *first = csr.neighbors_of(v, buffer.data());
+            for (const uint32_t *it = first; it != first + csr.degree(v); it++)
+                dominated[*it] = true;
+        }
+
+        return centers;
+    }
+
+} // namespace Spanner
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+#include "edge_accumulator.hpp"
+
+
+// Number of BFS of the additive spanner computed and merged together (one bit-parallel batch):
+#define ADDITIVE_BFS_BATCH 64
+
+// Sampled sources of the stretch evaluation when the additive spanner is built without --eval:
+#define ADDITIVE_EVAL_SOURCES 16
+
+
+namespace Spanner
+{
+
+    uint32_t heavy_degree_threshold(const Graph::CsrGraph &csr, uint32_t threshold);
+    size_t add_light_edges(const Graph::CsrGraph &csr, uint32_t threshold, EdgeAccumulator *span_edges);
+    std::vector<uint32_t> dominating_centers(const Graph::CsrGraph &csr, uint32_t threshold);
+
+} // namespace Spanner
@@ -0,0 +1,221 @@
+#include "baswana_sen.hpp"
+#include "edge_set.hpp"
+#include "run_report.hpp"
+
+#include <cmath>
+#include <numeric>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+
+
+namespace Spanner
+{
+
+    /**
+     ** cluster_sampled():
+     **     params:  center -> center of the cluster.
+     **              round -> clustering round.
+     **              seed -> seed of the construction.
+     **              probability -> probability to keep the cluster.
+     **
+     **     Seeded coin of a cluster at a round, a hash so that it does not depend on
+     **     the order in which the threads ask for it.
+     **/
+
+    static bool cluster_sampled(uint32_t center, uint32_t round, uint64_t seed, double probability)
+    {
+        uint64_t key = (static_cast<uint64_t>(round) << 32 | center) ^ seed;
+        return static_cast<double>(edge_hash(key)) < std::ldexp(probability, 64);
+    }
+
+
+    /**
+     ** connect_clusters():
+     **     params:  csr -> clustered graph.
+     **              clusters -> cluster center of each vertex (NO_VERTEX if unclustered).
+     **              v -> clustered vertex.
+     **              neighbors -> sorted neighbors of v (see CsrGraph::neighbors_of()).
+     **              adjacent -> scratch vector of (cluster, neighbor) pairs.
+     **              edges -> spanner edges of the chunk (u_0, v_0, u_1, v_1, ...).
+     **
+     **     Add one edge from v to each cluster adjacent to v: the edge to its smallest
+     **     neighbor in the cluster.
+     **/
+
+    static void connect_clusters(const Graph::CsrGraph &csr, const std::vector<uint32_t> &clusters, uint32_t v,
+            const uint32_t *neighbors, std::vector<std::pair<uint32_t, uint32_t>> *adjacent, std::vector<uint32_t> *edges)
+    {
+        adjacent->clear();
+        for (const uint32_t *it = neighbors; it != neighbors + csr.degree(v); it++)
+            if (clusters[*it] != NO_VERTEX && clusters[*it] != clusters[v])
+                adjacent->push_back(std::make_pair(clusters[*it], *it));
+
+        std::sort(adjacent->begin(), adjacent->end());
+
+        for (size_t i = 0; i < adjacent->size(); i++)
+        {
+            if (i == 0 || (*adjacent)[i].first != (*adjacent)[i - 1].first)
+            {
+                edges->push_back(v);
+                edges->push_back((*adjacent)[i].second);
+            }
+        }
+    }
+
+
+    /**
+     ** add_chunk_edges():
+     **     params:  chunk_edges -> edges found by each chunk, emptied.
+     **              span_edges -> accumulator of the spanner edges.
+     **
+     **     Add the edges in chunk order, so the spanner does not depend on the threads.
+     **/
+
+    static void add_chunk_edges(std::vector<std::vector<uint32_t>> *chunk_edges, EdgeAccumulator *span_edges)
+    {
+        for (std::vector<uint32_t> &edges : *chunk_edges)
+        {
+            for (size_t i = 0; i < edges.size(); i += 2)
+                span_edges->add_edge(edges[i], edges[i + 1]);
+            edges.clear();
+        }
+    }
+
+
+    /**
+     ** baswana_sen_spanner():
+     **     params:  csr -> graph to span.
+     **              k -> stretch parameter, the spanner is a (2k-1)-spanner.
+     **              seed -> seed of the cluster sampling.
+     **              pool -> threads sharing the vertices of a round.
+     **              span_edges -> accumulator receiving the spanner edges.
+     **
+     **     Randomized clustering spanner of Baswana and Sen, of expected size
+     **     O(k n^(1+1/k)) in O(k m) time. Every vertex starts as its own cluster. At each
+     **     of the k-1 rounds, every cluster is kept with probability n^(-1/k), then a
+     **     vertex whose cluster is dropped joins a kept neighbor cluster through one
+     **     edge, or, without such a neighbor, adds one edge to each adjacent cluster
+     **     and leaves the clustering. An edge is still to be spanned while both its
+     **     extremities are clustered in different clusters. Last, every clustered
+     **     vertex adds one edge to each adjacent cluster.
+     **
+     **     A round reads the clusters of the previous round only, so its vertices are
+     **     processed in parallel. Return the number of spanner edges.
+     **/
+
+    size_t baswana_sen_spanner(const Graph::CsrGraph &csr, uint32_t k, uint64_t seed, Parallel::ThreadPool &pool,
+            EdgeAccumulator *span_edges)
+    {
+        Report::ScopedPhase phase("baswana_sen");
+        std::cout << "\n\t\t_______________\n\n" << "Computing Baswana-Sen " << 2 * k - 1 << "-spanner ...\n";
+
+        uint32_t vertices_nb = csr.get_vertices_nb();
+        double probability = std::pow(static_cast<double>(vertices_nb), -1.0 / k);
+
+        std::vector<uint32_t> clusters(vertices_nb);
+        std::iota(clusters.begin(), clusters.end(), 0);
+        std::vector<uint32_t> next(vertices_nb);
+        std::vector<char> sampled(vertices_nb);
+
+        size_t chunks_nb = std::max<size_t>(std::min<size_t>(BASWANA_SEN_CHUNKS, vertices_nb), 1);
+        std::vector<std::vector<uint32_t>> chunk_edges(chunks_nb);
+        std::vector<std::vector<std::pair<uint32_t, uint32_t>>> adjacent(pool.get_threads_nb());
+        std::vector<std::vector<uint32_t>> buffers(pool.get_threads_nb(),
+                std::vector<uint32_t>(csr.neighbors_buffer_size()));
+
+        for (uint32_t round = 1; round < k; round++)
+        {
+            pool.run(chunks_nb, [&](size_t chunk, int)
+            {
+                for (uint32_t v = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+                        v < Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1); v++)
+                    sampled[v] = clusters[v] == v && cluster_sampled(v, round, seed, probability);
+            });
+
+            pool.run(chunks_nb, [&](size_t chunk, int thread_id)
+            {
+                std::vector<uint32_t> &edges = chunk_edges[chunk];
+                uint64_t edges_nb = 0;
+
+                for (uint32_t v = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+                        v < Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1); v++)
+                {
+                    uint32_t c = clusters[v];
+                    if (c == NO_VERTEX || sampled[c])
+                    {
+                        next[v] = c;
+                        continue;
+                    }
+
+                    uint32_t join = NO_VERTEX;
+                    const uint32_t *neighbors = csr.neighbors_of(v, buffers[thread_id].data());
+                    for (const uint32_t *it = neighbors; it != neighbors + csr.degree(v) && join == NO_VERTEX; it++)
+                    {
+                        edges_nb++;
+                        if (clusters[*it] != NO_VERTEX && sampled[clusters[*it]])
+                            join = *it;
+                    }
+
+                    if (join != NO_VERTEX)
+                    {
+                        edges.push_back(v);
+                        edges.push_back(join);
+                        next[v] = clusters[join];
+                    }
+                    else
+                    {
+                        edges_nb += csr.degree(v);
+                        connect_clusters(csr, clusters, v, neighbors, &(adjacent[thread_id]), &edges);
+                        next[v] = NO_VERTEX;
+                    }
+                }
+
+                Report::count_edges(edges_nb);
+            });
+
+            clusters.swap(next);
+            add_chunk_edges(&chunk_edges, span_edges);
+
+            if (!Report::is_quiet())
+            {
+                uint32_t clusters_nb = 0, clustered_nb = 0;
+                for (uint32_t v = 0; v < vertices_nb; v++)
+                {
+                    clusters_nb += clusters[v] == v;
+                    clustered_nb += clusters[v] != NO_VERTEX;
+                }
+
+                std::cout << "Round " << round << ": " << clusters_nb << " clusters of " << clustered_nb
+                    << " vertices, spanner edges " << span_edges->get_edges_nb() << ".\n";
+            }
+        }
+
+        // Join the remaining clusters:
+        pool.run(chunks_nb, [&](size_t chunk, int thread_id)
+        {
+            uint64_t edges_nb = 0;
+
+            for (uint32_t v = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+                    v < Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1); v++)
+            {
+                if (clusters[v] == NO_VERTEX)
+                    continue;
+
+                edges_nb += csr.degree(v);
+                connect_clusters(csr, clusters, v, csr.neighbors_of(v, buffers[thread_id].data()), &(adjacent[thread_id]),
+                        &(chunk_edges[chunk]));
+            }
+
+            Report::count_edges(edges_nb);
+        });
+
+        add_chunk_edges(&chunk_edges, span_edges);
+
+        std::cout << "Baswana-Sen spanner: " << span_edges->get_edges_nb() << " edges (k = " << k << ", seed "
+            << seed << ").\n";
+
+        return span_edges->get_edges_nb();
+    }
+
+} // namespace Spanner
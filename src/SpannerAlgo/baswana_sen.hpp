@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "edge_accumulator.hpp"
+
+
+// Vertex chunks of a clustering round (fixed for a result independent of the threads):
+#define BASWANA_SEN_CHUNKS 1024
+
+
+namespace Spanner
+{
+
+    size_t baswana_sen_spanner(const Graph::CsrGraph &csr, uint32_t k, uint64_t seed, Parallel::ThreadPool &pool,
+            EdgeAccumulator *span_edges);
+
+} // namespace Spanner
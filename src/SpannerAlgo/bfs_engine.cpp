@@ -0,0 +1,582 @@
+#include "bfs_engine.hpp"
+#include "run_report.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <algorithm>
+
+
+namespace Spanner
+{
+
+    /**
+     ** BfsEngine class constructor:
+     **     params:  csr -> graph traversed by the engine.
+     **              pool -> threads running the traversals.
+     **
+     **     Allocate one scratch per thread, sized for the graph.
+     **/
+
+    BfsEngine::BfsEngine(const Graph::CsrGraph &csr, Parallel::ThreadPool &pool)
+        : csr(csr), pool(pool), own_scratch(pool.get_threads_nb()), scratch(own_scratch), spill(NULL)
+    {
+        uint32_t vertices_nb = csr.get_vertices_nb();
+        uint32_t buffer_size = csr.neighbors_buffer_size();
+
+        for (BfsScratch &buffers : this->scratch)
+        {
+            buffers.queue.reserve(vertices_nb);
+            buffers.fathers.assign(vertices_nb, NO_VERTEX);
+            buffers.dists.assign(vertices_nb, NO_VERTEX);
+            buffers.neighbors.resize(buffer_size);
+        }
+    }
+
+
+    /**
+     ** BfsEngine class constructor:
+     **     params:  csr -> graph traversed by the engine, on the vertices of the graph of owner.
+     **              owner -> engine whose scratch and pool are used.
+     **
+     **     Share the scratch of owner instead of allocating another one per thread: a
+     **     thread must finish its traversal of one graph before starting one of the other.
+     **/
+
+    BfsEngine::BfsEngine(const Graph::CsrGraph &csr, BfsEngine &owner)
+        : csr(csr), pool(owner.pool), scratch(owner.scratch), spill(NULL)
+    {
+        if (csr.get_vertices_nb() != owner.csr.get_vertices_nb())
+        {
+            std::cerr << "Error: BFS engines sharing their scratch must have the same vertices" << std::endl;
+            exit(1);
+        }
+
+        uint32_t buffer_size = csr.neighbors_buffer_size();
+        for (BfsScratch &buffers : this->scratch)
+            if (buffers.neighbors.size() < buffer_size)
+                buffers.neighbors.resize(buffer_size);
+    }
+
+
+    /**
+     ** run():
+     **     params:  roots -> internal ids of the BFS roots.
+     **              results -> BFS results, results[i] is the traversal from roots[i].
+     **              fields -> optional fields of the results (BFS_KEEP_ORDER, BFS_KEEP_RANKS).
+     **
+     **     Compute all traversals in parallel, one task per root.
+     **/
+
+    void BfsEngine::run(const std::vector<uint32_t> &roots, std::vector<BfsResult> *results, int fields)
+    {
+        results->resize(roots.size());
+
+        this->pool.run(roots.size(), [this, &roots, results, fields](size_t i, int thread_id)
+        {
+            BfsScratch &buffers = this->scratch[thread_id];
+
+            this->traverse(roots[i], buffers);
+            this->commit(roots[i], buffers, &((*results)[i]), fields);
+        });
+    }
+
+
+    /**
+     ** traverse():
+     **     params:  root -> internal id of the BFS root.
+     **              buffers -> scratch of the running thread.
+     **
+     **     Breadth-First Search on the contiguous CSR neighbors arrays (decoded list
+     **     by list when the graph is compressed). The queue keeps the visited vertices
+     **     in BFS order.
+     **/
+
+    void BfsEngine::traverse(uint32_t root, BfsScratch &buffers)
+    {
+        std::vector<uint32_t> &queue = buffers.queue;
+        uint32_t *fathers = buffers.fathers.data();
+        uint32_t *dists = buffers.dists.data();
+        uint32_t *buffer = buffers.neighbors.data();
+
+        queue.clear();
+        queue.push_back(root);
+        fathers[root] = root;
+        dists[root] = 0;
+        uint64_t edges_nb = 0;
+
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            uint32_t u = queue[head];
+            uint32_t next_dist = dists[u] + 1;
+            uint32_t degree = this->csr.degree(u);
+            edges_nb += degree;
+
+            const uint32_t *first = this->csr.neighbors_of(u, buffer);
+            for (const uint32_t *it = first; it != first + degree; it++)
+            {
+                if (dists[*it] == NO_VERTEX)
+                {
+                    dists[*it] = next_dist;
+                    fathers[*it] = u;
+                    queue.push_back(*it);
+                }
+            }
+        }
+
+        Report::count_edges(edges_nb);
+        Report::count_bfs();
+    }
+
+
+    /**
+     ** distances():
+     **     params:  root -> internal id of the BFS root.
+     **              dists -> distance of each vertex from root (NO_VERTEX if unreached).
+     **
+     **     Single traversal done by the calling thread, for algorithms choosing each
+     **     root from the previous results. Only the distances are copied out.
+     **     Return the eccentricity of root in its component.
+     **/
+
+    uint32_t BfsEngine::distances(uint32_t root, std::vector<uint32_t> *dists)
+    {
+        BfsScratch &buffers = this->scratch[0];
+
+        this->traverse(root, buffers);
+        dists->assign(this->csr.get_vertices_nb(), NO_VERTEX);
+
+        for (uint32_t v : buffers.queue)
+        {
+            (*dists)[v] = buffers.dists[v];
+            buffers.fathers[v] = NO_VERTEX;
+            buffers.dists[v] = NO_VERTEX;
+        }
+
+        return (*dists)[buffers.queue.back()];
+    }
+
+
+    /**
+     ** eccentricities():
+     **     params:  roots -> internal ids of the BFS roots.
+     **              eccs -> eccentricity of each root in its component.
+     **              farthest -> if not NULL, a vertex at distance eccs[i] from roots[i].
+     **
+     **     Compute the eccentricities of a batch of roots in parallel, one task per
+     **     root. Nothing but the eccentricity is kept from each traversal.
+     **/
+
+    void BfsEngine::eccentricities(const std::vector<uint32_t> &roots, std::vector<uint32_t> *eccs, std::vector<uint32_t> *farthest)
+    {
+        eccs->resize(roots.size());
+        if (farthest)
+            farthest->resize(roots.size());
+
+        this->pool.run(roots.size(), [this, &roots, eccs, farthest](size_t i, int thread_id)
+        {
+            BfsScratch &buffers = this->scratch[thread_id];
+
+            this->traverse(roots[i], buffers);
+            (*eccs)[i] = buffers.dists[buffers.queue.back()];
+            if (farthest)
+                (*farthest)[i] = buffers.queue.back();
+
+            for (uint32_t v : buffers.queue)
+            {
+                buffers.fathers[v] = NO_VERTEX;
+                buffers.dists[v] = NO_VERTEX;
+            }
+        });
+    }
+
+
+    /**
+     ** run_direction_optimizing():
+     **     params:  roots -> internal ids of the BFS roots.
+     **              results -> BFS results, results[i] is the traversal from roots[i].
+     **              alpha -> a top-down level switches to bottom-up when the frontier edges
+     **                       exceed unexplored edges / alpha.
+     **              beta -> a bottom-up level switches back to top-down when the frontier
+     **                      vertices are less than vertices / beta.
+     **              fields -> optional fields of the results (BFS_KEEP_ORDER, BFS_KEEP_RANKS).
+     **
+     **     Compute all traversals in parallel with the direction-optimizing kernel,
+     **     one task per root.
+     **/
+
+    void BfsEngine::run_direction_optimizing(const std::vector<uint32_t> &roots, std::vector<BfsResult> *results, double alpha, double beta, int fields)
+    {
+        results->resize(roots.size());
+
+        this->pool.run(roots.size(), [this, &roots, results, alpha, beta, fields](size_t i, int thread_id)
+        {
+            BfsScratch &buffers = this->scratch[thread_id];
+
+            if (buffers.frontier_bits.empty())
+                buffers.frontier_bits.assign(this->csr.get_vertices_nb() / 64 + 1, 0);
+
+            this->traverse_direction_optimizing(roots[i], buffers, alpha, beta);
+            this->commit(roots[i], buffers, &((*results)[i]), fields);
+        });
+    }
+
+
+    /**
+     ** traverse_direction_optimizing():
+     **     params:  root -> internal id of the BFS root.
+     **              buffers -> scratch of the running thread.
+     **              alpha -> top-down to bottom-up switching threshold.
+     **              beta -> bottom-up to top-down switching threshold.
+     **
+     **     Level-synchronous BFS choosing the direction of each level (Beamer et al.):
+     **         top-down: frontier vertices push to their unvisited neighbors.
+     **         bottom-up: unvisited vertices look for a neighbor in the frontier bitmap
+     **                    and stop at the first one found.
+     **     Bottom-up levels inspect far fewer edges when the frontier is large, which is
+     **     the case of the middle levels of low-diameter graphs with heavy-tailed degrees.
+     **     The queue keeps the visited vertices in BFS order in both directions.
+     **/
+
+    void BfsEngine::traverse_direction_optimizing(uint32_t root, BfsScratch &buffers, double alpha, double beta)
+    {
+        uint32_t vertices_nb = this->csr.get_vertices_nb();
+        std::vector<uint32_t> &queue = buffers.queue;
+        uint32_t *fathers = buffers.fathers.data();
+        uint32_t *dists = buffers.dists.data();
+        uint64_t *frontier_bits = buffers.frontier_bits.data();
+        uint32_t *buffer = buffers.neighbors.data();
+
+        queue.clear();
+        queue.push_back(root);
+        fathers[root] = root;
+        dists[root] = 0;
+
+        uint64_t unexplored_edges = 2 * this->csr.get_edges_nb() - this->csr.degree(root);
+        size_t level_begin = 0;
+        size_t level_end = 1;
+        uint32_t dist = 0;
+        bool top_down = true;
+        uint64_t edges_nb = 0;
+
+        while (level_begin < level_end)
+        {
+            dist++;
+
+            uint64_t frontier_edges = 0;
+            for (size_t k = level_begin; k < level_end; k++)
+                frontier_edges += this->csr.degree(queue[k]);
+
+            if (top_down && frontier_edges > unexplored_edges / alpha)
+                top_down = false;
+            else if (!top_down && (level_end - level_begin) < vertices_nb / beta)
+                top_down = true;
+
+            if (top_down)
+            {
+                for (size_t k = level_begin; k < level_end; k++)
+                {
+                    uint32_t u = queue[k];
+                    uint32_t degree = this->csr.degree(u);
+                    edges_nb += degree;
+
+                    const uint32_t *first = this->csr.neighbors_of(u, buffer);
+                    for (const uint32_t *it = first; it != first + degree; it++)
+                    {
+                        if (dists[*it] == NO_VERTEX)
+                        {
+                            dists[*it] = dist;
+                            fathers[*it] = u;
+                            queue.push_back(*it);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                for (size_t k = level_begin; k < level_end; k++)
+                    frontier_bits[queue[k] >> 6] |= 1ULL << (queue[k] & 63);
+
+                for (uint32_t v = 0; v < vertices_nb; v++)
+                {
+                    if (dists[v] != NO_VERTEX)
+                        continue;
+
+                    const uint32_t *first = this->csr.neighbors_of(v, buffer);
+                    for (const uint32_t *it = first; it != first + this->csr.degree(v); it++)
+                    {
+                        edges_nb++;
+                        if (frontier_bits[*it >> 6] & (1ULL << (*it & 63)))
+                        {
+                            dists[v] = dist;
+                            fathers[v] = *it;
+                            queue.push_back(v);
+                            break;
+                        }
+                    }
+                }
+
+                for (size_t k = level_begin; k < level_end; k++)
+                    frontier_bits[queue[k] >> 6] = 0;
+            }
+
+            for (size_t k = level_end; k < queue.size(); k++)
+                unexplored_edges -= this->csr.degree(queue[k]);
+
+            level_begin = level_end;
+            level_end = queue.size();
+        }
+
+        Report::count_edges(edges_nb);
+        Report::count_bfs();
+    }
+
+
+    /**
+     ** commit():
+     **     params:  root -> internal id of the BFS root.
+     **              buffers -> scratch holding the last traversal of the thread.
+     **              result -> BFS result to fill.
+     **              fields -> optional fields of the result (BFS_KEEP_ORDER, BFS_KEEP_RANKS).
+     **
+     **     Copy the traversal into its compact result, then reset the touched scratch
+     **     entries. The last vertex of the queue gives the width of the distances.
+     **/
+
+    void BfsEngine::commit(uint32_t root, BfsScratch &buffers, BfsResult *result, int fields)
+    {
+        uint32_t vertices_nb = this->csr.get_vertices_nb();
+
+        result->allocate(root, vertices_nb, buffers.dists[buffers.queue.back()], this->spill, &this->blocks);
+        result->order.clear();
+        result->ranks.clear();
+
+        if (fields & BFS_KEEP_ORDER)
+            result->order = buffers.queue;
+        if (fields & BFS_KEEP_RANKS)
+            result->ranks.assign(vertices_nb, NO_VERTEX);
+
+        for (uint32_t rank = 0; rank < buffers.queue.size(); rank++)
+        {
+            uint32_t v = buffers.queue[rank];
+
+            result->set(v, buffers.fathers[v], buffers.dists[v]);
+            if (fields & BFS_KEEP_RANKS)
+                result->ranks[v] = rank;
+
+            buffers.fathers[v] = NO_VERTEX;
+            buffers.dists[v] = NO_VERTEX;
+        }
+    }
+
+
+    /**
+     ** run_bit_parallel():
+     **     params:  roots -> internal ids of the BFS roots.
+     **              results -> BFS results, results[i] is the traversal from roots[i].
+     **              fields -> optional fields of the results (BFS_KEEP_ORDER, BFS_KEEP_RANKS).
+     **
+     **     Compute the traversals by batches of BIT_PARALLEL_BATCH sources. In a batch,
+     **     each vertex holds one bit per source in a machine word, so each level streams
+     **     the adjacency arrays once for all the sources of the batch.
+     **/
+
+    void BfsEngine::run_bit_parallel(const std::vector<uint32_t> &roots, std::vector<BfsResult> *results, int fields)
+    {
+        results->resize(roots.size());
+
+        for (size_t first = 0; first < roots.size(); first += BIT_PARALLEL_BATCH)
+        {
+            size_t batch_size = std::min(static_cast<size_t>(BIT_PARALLEL_BATCH), roots.size() - first);
+            this->bit_parallel_batch(roots.data() + first, batch_size, results->data() + first, fields);
+        }
+    }
+
+
+    /**
+     ** bit_parallel_batch():
+     **     params:  roots -> internal ids of the batch roots.
+     **              batch_size -> number of roots in the batch (at most 64).
+     **              results -> BFS results of the batch roots.
+     **              fields -> optional fields of the results (BFS_KEEP_ORDER, BFS_KEEP_RANKS).
+     **
+     **     Level-synchronous bit-parallel BFS. At each level, every vertex not yet reached
+     **     by all sources ORs the frontier words of its neighbors: the bits not yet seen
+     **     are the sources reaching it at this level. The father for a source is the first
+     **     neighbor (in sorted adjacency order) having the source bit in the frontier, so
+     **     the result does not depend on the number of threads. Fathers and distances are
+     **     written in the compact results when a vertex is discovered, the distances
+     **     start at 1 byte and are widened if a root turns out to be that eccentric.
+     **/
+
+    void BfsEngine::bit_parallel_batch(const uint32_t *roots, size_t batch_size, BfsResult *results, int fields)
+    {
+        uint32_t vertices_nb = this->csr.get_vertices_nb();
+        uint64_t batch_mask = (batch_size == 64) ? ~0ULL : ((1ULL << batch_size) - 1);
+
+        std::vector<uint64_t> seen(vertices_nb, 0);
+        std::vector<uint64_t> frontier(vertices_nb, 0);
+        std::vector<uint64_t> next(vertices_nb, 0);
+
+        // Vertices reached by each source, counted by each thread:
+        std::vector<std::vector<uint32_t>> reached(this->pool.get_threads_nb(), std::vector<uint32_t>(batch_size, 0));
+
+        this->pool.run(batch_size, [&](size_t i, int)
+        {
+            results[i].allocate(roots[i], vertices_nb, 0, this->spill, &this->blocks);
+            results[i].place(roots[i], roots[i], 0);
+        });
+
+        for (size_t i = 0; i < batch_size; i++)
+        {
+            seen[roots[i]] |= 1ULL << i;
+            frontier[roots[i]] |= 1ULL << i;
+            reached[0][i]++;
+        }
+
+        size_t chunks_nb = 8 * this->pool.get_threads_nb();
+        uint64_t active = batch_mask;
+        uint32_t dist = 0;
+
+        while (active)
+        {
+            dist++;
+
+            // Only the sources with a non-empty frontier can store this distance:
+            for (uint64_t bits = active; bits; bits &= bits - 1)
+                results[__builtin_ctzll(bits)].widen(dist, this->spill, &this->blocks);
+
+            std::atomic<uint64_t> level_bits(0);
+
+            this->pool.run(chunks_nb, [&](size_t chunk, int thread_id)
+            {
+                uint32_t first = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+                uint32_t last = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1);
+                uint32_t *buffer = this->scratch[thread_id].neighbors.data();
+                std::vector<uint32_t> &reached_nb = reached[thread_id];
+                uint64_t chunk_bits = 0;
+                uint64_t chunk_edges_nb = 0;
+
+                for (uint32_t v = first; v < last; v++)
+                {
+                    uint64_t missing = ~seen[v] & batch_mask;
+                    if (!missing)
+                        continue;
+
+                    uint32_t degree = this->csr.degree(v);
+                    chunk_edges_nb += degree;
+
+                    uint64_t incoming = 0;
+                    const uint32_t *neighbors = this->csr.neighbors_of(v, buffer);
+                    for (const uint32_t *it = neighbors; it != neighbors + degree; it++)
+                        incoming |= frontier[*it];
+
+                    uint64_t new_bits = incoming & missing;
+                    next[v] = new_bits;
+                    if (!new_bits)
+                        continue;
+
+                    chunk_bits |= new_bits;
+
+                    // Choose the father of v for each newly reaching source:
+                    uint64_t remaining = new_bits;
+                    for (const uint32_t *it = neighbors; remaining; it++)
+                    {
+                        uint64_t bits = frontier[*it] & remaining;
+                        remaining &= ~bits;
+
+                        while (bits)
+                        {
+                            int i = __builtin_ctzll(bits);
+                            bits &= bits - 1;
+                            results[i].place(v, *it, dist);
+                            reached_nb[i]++;
+                        }
+                    }
+                }
+
+                if (chunk_bits)
+                    level_bits |= chunk_bits;
+                Report::count_edges(chunk_edges_nb);
+            });
+
+            // Next frontier is the set of bits discovered at this level:
+            this->pool.run(chunks_nb, [&](size_t chunk, int)
+            {
+                uint32_t first = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+                uint32_t last = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1);
+
+                for (uint32_t v = first; v < last; v++)
+                {
+                    seen[v] |= next[v];
+                    frontier[v] = next[v];
+                    next[v] = 0;
+                }
+            });
+
+            active = level_bits;
+            for (uint64_t bits = active; bits; bits &= bits - 1)
+                results[__builtin_ctzll(bits)].max_dist = dist;
+        }
+
+        this->pool.run(batch_size, [&](size_t i, int)
+        {
+            results[i].reached_nb = 0;
+            for (const std::vector<uint32_t> &reached_nb : reached)
+                results[i].reached_nb += reached_nb[i];
+
+            this->build_order(&(results[i]), fields);
+        });
+
+        Report::count_bfs(batch_size);
+    }
+
+
+    /**
+     ** build_order():
+     **     params:  result -> BFS result with its tree filled.
+     **              fields -> optional fields to fill (BFS_KEEP_ORDER, BFS_KEEP_RANKS).
+     **
+     **     Fill the requested order and ranks vectors by counting sort of the vertices
+     **     on their distance (vertices of a same level are sorted by id).
+     **/
+
+    void BfsEngine::build_order(BfsResult *result, int fields)
+    {
+        result->order.clear();
+        result->ranks.clear();
+
+        if (!fields)
+            return;
+
+        uint32_t vertices_nb = this->csr.get_vertices_nb();
+        uint32_t max_dist = result->max_dist;
+        std::vector<uint32_t> level_start(max_dist + 2, 0);
+
+        for (uint32_t v = 0; v < vertices_nb; v++)
+            if (result->dist(v) != NO_VERTEX)
+                level_start[result->dist(v) + 1]++;
+
+        for (uint32_t d = 0; d <= max_dist; d++)
+            level_start[d + 1] += level_start[d];
+
+        std::vector<uint32_t> order(level_start[max_dist + 1]);
+        if (fields & BFS_KEEP_RANKS)
+            result->ranks.assign(vertices_nb, NO_VERTEX);
+
+        for (uint32_t v = 0; v < vertices_nb; v++)
+        {
+            uint32_t dist = result->dist(v);
+            if (dist == NO_VERTEX)
+                continue;
+
+            uint32_t rank = level_start[dist]++;
+            order[rank] = v;
+            if (fields & BFS_KEEP_RANKS)
+                result->ranks[v] = rank;
+        }
+
+        if (fields & BFS_KEEP_ORDER)
+            result->order = std::move(order);
+    }
+
+} // namespace Spanner
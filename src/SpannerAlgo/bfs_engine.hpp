@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "bfs_result.hpp"
+
+
+// Number of sources advanced together by the bit-parallel BFS (bits of a machine word):
+#define BIT_PARALLEL_BATCH 64
+
+// Default switching thresholds of the direction-optimizing BFS (Beamer et al.):
+#define DO_BFS_ALPHA 14.0
+#define DO_BFS_BETA 24.0
+
+
+namespace Spanner
+{
+
+    /**
+     ** BFS_BACKEND enum:
+     **     Implementation used by pre_compute_bfs().
+     **         IGRAPH -> one igraph_bfs() call per source (reference path).
+     **         QUEUE -> one queue BFS per source on the CSR graph, sources run in parallel.
+     **         BIT_PARALLEL -> up to 64 sources advanced together, one bit per source.
+     **         DIRECTION_OPTIMIZING -> one BFS per source switching between top-down
+     **                                 and bottom-up levels, sources run in parallel.
+     **/
+
+    enum BFS_BACKEND
+    {
+        IGRAPH,
+        QUEUE,
+        BIT_PARALLEL,
+        DIRECTION_OPTIMIZING
+    };
+
+
+    /**
+     ** BfsScratch structure:
+     **     Per-thread traversal buffers, allocated once and reused by every BFS of
+     **     the thread. dists is kept filled with NO_VERTEX between two traversals.
+     **/
+
+    struct BfsScratch
+    {
+        std::vector<uint32_t> queue; // visited vertices in BFS order.
+        std::vector<uint32_t> fathers; // parent of each visited vertex.
+        std::vector<uint32_t> dists; // distance of each visited vertex.
+        std::vector<uint64_t> frontier_bits; // frontier bitmap of bottom-up levels (kept cleared).
+        std::vector<uint32_t> neighbors; // decoded neighbors list (compressed graphs only).
+    };
+
+
+    /**
+     ** BfsEngine class:
+     **     Run independent BFS traversals of a CSR graph concurrently on a thread pool.
+     **     Each traversal is done by a single thread in its own scratch buffers, so the
+     **     results do not depend on the number of threads. Engines of graphs on the same
+     **     vertices can share their scratch when their traversals never overlap.
+     **/
+
+    class BfsEngine
+    {
+        public:
+
+            BfsEngine(const Graph::CsrGraph &csr, Parallel::ThreadPool &pool);
+            BfsEngine(const Graph::CsrGraph &csr, BfsEngine &owner);
+
+            void run(const std::vector<uint32_t> &roots, std::vector<BfsResult> *results, int fields = 0);
+            void run_bit_parallel(const std::vector<uint32_t> &roots, std::vector<BfsResult> *results, int fields = 0);
+            void run_direction_optimizing(const std::vector<uint32_t> &roots, std::vector<BfsResult> *results,
+                    double alpha = DO_BFS_ALPHA, double beta = DO_BFS_BETA, int fields = 0);
+            void set_spill(BfsSpill *spill);
+            uint32_t distances(uint32_t root, std::vector<uint32_t> *dists);
+            void eccentricities(const std::vector<uint32_t> &roots, std::vector<uint32_t> *eccs,
+                    std::vector<uint32_t> *farthest = NULL);
+
+            template <typename Visitor>
+            void visit(uint32_t root, int thread_id, Visitor visit);
+
+        private:
+
+            const Graph::CsrGraph &csr; // traversed graph.
+            Parallel::ThreadPool &pool; // threads running the traversals.
+            std::vector<BfsScratch> own_scratch; // scratch allocated by this engine (empty if shared).
+            std::vector<BfsScratch> &scratch; // one scratch per pool thread, own or of another engine.
+            BfsSpill *spill; // scratch file receiving the results (NULL for the heap).
+            BfsBlockPool blocks; // heap blocks of the results, reused once released.
+
+            // Methods:
+            void traverse(uint32_t root, BfsScratch &buffers);
+            void traverse_direction_optimizing(uint32_t root, BfsScratch &buffers, double alpha, double beta);
+            void commit(uint32_t root, BfsScratch &buffers, BfsResult *result, int fields);
+            void bit_parallel_batch(const uint32_t *roots, size_t batch_size, BfsResult *results, int fields);
+            void build_order(BfsResult *result, int fields);
+
+    };
+
+
+
+    /**
+     ** set_spill():
+     **     params:  spill -> scratch file receiving the next results, NULL for the block pool.
+     **/
+
+    inline void BfsEngine::set_spill(BfsSpill *spill)
+    {
+        this->spill = spill;
+    }
+
+
+    /**
+     ** visit():
+     **     params:  root -> internal id of the BFS root.
+     **              thread_id -> id of the calling pool thread, selecting its scratch.
+     **              visit -> callable visit(const BfsScratch &) reading the traversal.
+     **
+     **     Traverse from root in the scratch of the calling thread and let visit read
+     **     the queue and distances in place, without copying a BfsResult. Called from
+     **     a task of the engine pool, so several engines can share the same task.
+     **/
+
+    template <typename Visitor>
+    void BfsEngine::visit(uint32_t root, int thread_id, Visitor visit)
+    {
+        BfsScratch &buffers = this->scratch[thread_id];
+
+        this->traverse(root, buffers);
+        visit(static_cast<const BfsScratch &>(buffers));
+
+        for (uint32_t v : buffers.queue)
+        {
+            buffers.fathers[v] = NO_VERTEX;
+            buffers.dists[v] = NO_VERTEX;
+        }
+    }
+
+} // namespace Spanner
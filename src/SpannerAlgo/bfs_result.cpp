@@ -0,0 +1,332 @@
+#include "bfs_result.hpp"
+
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+
+namespace Spanner
+{
+
+    /**
+     ** BfsSpill class constructor:
+     **     params:  filename -> path of the scratch file (created, then unlinked).
+     **/
+
+    BfsSpill::BfsSpill(std::string filename)
+        : file(std::make_shared<SpillFile>())
+    {
+        this->file->file_size = 0;
+        this->file->fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (this->file->fd < 0)
+        {
+            std::cerr << "Error: can't create the BFS spill file " << filename << std::endl;
+            exit(1);
+        }
+
+        unlink(filename.c_str());
+    }
+
+
+    /**
+     ** SpillFile structure destructor:
+     **     close the scratch file, once the spill and all the blocks in use are gone.
+     **/
+
+    BfsSpill::SpillFile::~SpillFile()
+    {
+        if (this->fd >= 0)
+            close(this->fd);
+    }
+
+
+    /**
+     ** allocate():
+     **     params:  size -> size of the block in bytes.
+     **
+     **     Map a released region of the same page aligned size, or extend the file with
+     **     a new one. When the last owner of the returned pointer releases it, the
+     **     mapping is removed, the region is punched out of the file (its disk blocks
+     **     are freed) and it goes back to the free list.
+     **/
+
+    std::shared_ptr<void> BfsSpill::allocate(size_t size)
+    {
+        std::shared_ptr<SpillFile> file = this->file;
+        size_t page_size = sysconf(_SC_PAGESIZE);
+        size_t region_size = (size + page_size - 1) / page_size * page_size;
+        size_t offset = SIZE_MAX;
+
+        if (region_size == 0)
+            return std::shared_ptr<void>();
+
+        {
+            std::lock_guard<std::mutex> guard(file->lock);
+            std::vector<std::pair<size_t, size_t>> &regions = file->regions;
+
+            for (size_t i = regions.size(); i > 0; i--)
+            {
+                if (regions[i - 1].first == region_size)
+                {
+                    offset = regions[i - 1].second;
+                    regions[i - 1] = regions.back();
+                    regions.pop_back();
+                    break;
+                }
+            }
+
+            if (offset == SIZE_MAX)
+            {
+                offset = file->file_size;
+                file->file_size += region_size;
+
+                if (ftruncate(file->fd, file->file_size) != 0)
+                {
+                    std::cerr << "Error: can't extend the BFS spill file" << std::endl;
+                    exit(1);
+                }
+            }
+        }
+
+        void *block = mmap(NULL, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, offset);
+        if (block == MAP_FAILED)
+        {
+            std::cerr << "Error: can't map the BFS spill file" << std::endl;
+            exit(1);
+        }
+
+        return std::shared_ptr<void>(block, [file, region_size, offset](void *p)
+        {
+            munmap(p, region_size);
+
+            // Not supported by every file system: the region is then only reused.
+            fallocate(file->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, region_size);
+
+            std::lock_guard<std::mutex> guard(file->lock);
+            file->regions.push_back(std::make_pair(region_size, offset));
+        });
+    }
+
+
+    /**
+     ** malloc_block():
+     **     params:  size -> size of the block in bytes.
+     **/
+
+    static void *malloc_block(size_t size)
+    {
+        void *block = malloc(size);
+        if (!block && size > 0)
+        {
+            std::cerr << "Error: malloc can't allocate a BFS result" << std::endl;
+            exit(1);
+        }
+
+        return block;
+    }
+
+
+    /**
+     ** BfsBlockPool class constructor:
+     **     the pool starts empty, blocks are allocated on demand.
+     **/
+
+    BfsBlockPool::BfsBlockPool()
+        : free_blocks(std::make_shared<FreeBlocks>())
+    {
+    }
+
+
+    /**
+     ** FreeBlocks structure destructor:
+     **     free the released blocks, once the pool and all the blocks in use are gone.
+     **/
+
+    BfsBlockPool::FreeBlocks::~FreeBlocks()
+    {
+        for (const std::pair<size_t, void *> &block : this->blocks)
+            free(block.second);
+    }
+
+
+    /**
+     ** allocate():
+     **     params:  size -> size of the block in bytes.
+     **
+     **     Reuse a released block of the same size, or allocate a new one. The block
+     **     goes back to the free list when the last owner of the returned pointer
+     **     releases it.
+     **/
+
+    std::shared_ptr<void> BfsBlockPool::allocate(size_t size)
+    {
+        std::shared_ptr<FreeBlocks> free_blocks = this->free_blocks;
+        void *block = NULL;
+
+        {
+            std::lock_guard<std::mutex> guard(free_blocks->lock);
+            std::vector<std::pair<size_t, void *>> &blocks = free_blocks->blocks;
+
+            for (size_t i = blocks.size(); i > 0; i--)
+            {
+                if (blocks[i - 1].first == size)
+                {
+                    block = blocks[i - 1].second;
+                    blocks[i - 1] = blocks.back();
+                    blocks.pop_back();
+                    break;
+                }
+            }
+        }
+
+        if (!block)
+            block = malloc_block(size);
+
+        return std::shared_ptr<void>(block, [free_blocks, size](void *p)
+        {
+            std::lock_guard<std::mutex> guard(free_blocks->lock);
+            free_blocks->blocks.push_back(std::make_pair(size, p));
+        });
+    }
+
+
+    /**
+     ** allocate_block():
+     **     params:  size -> size of the block in bytes.
+     **              spill -> scratch file, or NULL.
+     **              blocks -> pool of heap blocks, or NULL for a plain heap block.
+     **/
+
+    static std::shared_ptr<void> allocate_block(size_t size, BfsSpill *spill, BfsBlockPool *blocks)
+    {
+        if (spill)
+            return spill->allocate(size);
+
+        if (blocks)
+            return blocks->allocate(size);
+
+        return std::shared_ptr<void>(malloc_block(size), free);
+    }
+
+
+    /**
+     ** allocate():
+     **     params:  root -> internal id of the BFS root.
+     **              vertices_nb -> number of vertices of the traversed graph.
+     **              max_dist -> largest distance of the traversal.
+     **              spill -> scratch file receiving the arrays, or NULL for the heap.
+     **              blocks -> pool reusing the heap blocks of released results, or NULL.
+     **
+     **     Allocate the tree arrays with the narrowest distance width able to store
+     **     max_dist besides the unreached marker, every vertex starting unreached.
+     **/
+
+    void BfsResult::allocate(uint32_t root, uint32_t vertices_nb, uint32_t max_dist, BfsSpill *spill,
+            BfsBlockPool *blocks)
+    {
+        this->root = root;
+        this->vertices_nb = vertices_nb;
+        this->max_dist = max_dist;
+        this->reached_nb = 0;
+        this->dist_bytes = dist_width(max_dist);
+
+        this->fathers_storage = allocate_block(static_cast<size_t>(vertices_nb) * sizeof(uint32_t), spill, blocks);
+        this->dists_storage = allocate_block(static_cast<size_t>(vertices_nb) * this->dist_bytes, spill, blocks);
+        this->fathers = static_cast<uint32_t *>(this->fathers_storage.get());
+        this->dists = static_cast<uint8_t *>(this->dists_storage.get());
+
+        // NO_VERTEX and the unreached markers of every width are all bits set.
+        memset(this->fathers, 0xFF, static_cast<size_t>(vertices_nb) * sizeof(uint32_t));
+        memset(this->dists, 0xFF, static_cast<size_t>(vertices_nb) * this->dist_bytes);
+    }
+
+
+    /**
+     ** set():
+     **     params:  v -> reached vertex.
+     **              father -> parent of v in the BFS tree.
+     **              dist -> distance of v from the root (at most max_dist).
+     **/
+
+    void BfsResult::set(uint32_t v, uint32_t father, uint32_t dist)
+    {
+        this->place(v, father, dist);
+        this->reached_nb++;
+    }
+
+
+    /**
+     ** place():
+     **     params:  see set().
+     **
+     **     set() without counting v, so several threads can fill the same result (on
+     **     distinct vertices). The caller sets reached_nb and max_dist at the end.
+     **/
+
+    void BfsResult::place(uint32_t v, uint32_t father, uint32_t dist)
+    {
+        this->fathers[v] = father;
+        store_dist(this->dists, this->dist_bytes, v, dist);
+    }
+
+
+    /**
+     ** widen():
+     **     params:  dist -> distance about to be stored.
+     **              spill -> scratch file receiving the new array, or NULL for the heap.
+     **              blocks -> pool reusing the heap blocks of released results, or NULL.
+     **
+     **     Move the distances to a wider array if the current width can't store dist,
+     **     for traversals which do not know the eccentricity of their root in advance
+     **     (at most twice per result, and only beyond 254 levels).
+     **/
+
+    void BfsResult::widen(uint32_t dist, BfsSpill *spill, BfsBlockPool *blocks)
+    {
+        int dist_bytes = dist_width(dist);
+        if (dist_bytes <= this->dist_bytes)
+            return;
+
+        std::shared_ptr<void> storage = allocate_block(static_cast<size_t>(this->vertices_nb) * dist_bytes, spill, blocks);
+        uint8_t *dists = static_cast<uint8_t *>(storage.get());
+
+        for (uint32_t v = 0; v < this->vertices_nb; v++)
+            store_dist(dists, dist_bytes, v, this->dist(v));
+
+        this->dists_storage = storage;
+        this->dists = dists;
+        this->dist_bytes = dist_bytes;
+    }
+
+
+    /**
+     ** release_fathers():
+     **     Free the fathers array when only the distances are still needed, father()
+     **     must not be called anymore.
+     **/
+
+    void BfsResult::release_fathers()
+    {
+        this->fathers_storage.reset();
+        this->fathers = NULL;
+    }
+
+
+    /**
+     ** memory_size():
+     **     Return the size of the arrays of the result in bytes.
+     **/
+
+    size_t BfsResult::memory_size() const
+    {
+        size_t size = (this->order.size() + this->ranks.size()) * sizeof(uint32_t);
+        if (this->fathers)
+            size += static_cast<size_t>(this->vertices_nb) * sizeof(uint32_t);
+
+        return size + static_cast<size_t>(this->vertices_nb) * this->dist_bytes;
+    }
+
+} // namespace Spanner
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+
+
+// Optional fields of a BfsResult, the tree (fathers and distances) is always kept:
+#define BFS_KEEP_ORDER 1
+#define BFS_KEEP_RANKS 2
+
+
+namespace Spanner
+{
+
+    /**
+     ** dist_width():
+     **     params:  max_dist -> largest distance stored.
+     **
+     **     Return the narrowest distance width (in bytes) able to store max_dist
+     **     besides the unreached marker (all bits set).
+     **/
+
+    inline int dist_width(uint32_t max_dist)
+    {
+        return (max_dist < UINT8_MAX) ? 1 : (max_dist < UINT16_MAX) ? 2 : 4;
+    }
+
+
+    /**
+     ** store_dist():
+     **     params:  dists -> distances array.
+     **              dist_bytes -> width of a distance.
+     **              v -> vertex.
+     **              dist -> distance stored (NO_VERTEX gives the unreached marker).
+     **/
+
+    inline void store_dist(uint8_t *dists, int dist_bytes, uint32_t v, uint32_t dist)
+    {
+        switch (dist_bytes)
+        {
+        case 1:
+            dists[v] = dist;
+            break;
+        case 2:
+            reinterpret_cast<uint16_t *>(dists)[v] = dist;
+            break;
+        default:
+            reinterpret_cast<uint32_t *>(dists)[v] = dist;
+            break;
+        }
+    }
+
+
+    /**
+     ** load_dist():
+     **     params:  see store_dist().
+     **
+     **     Return the distance of v, NO_VERTEX if unreached.
+     **/
+
+    inline uint32_t load_dist(const uint8_t *dists, int dist_bytes, uint32_t v)
+    {
+        switch (dist_bytes)
+        {
+        case 1:
+            return dists[v] == UINT8_MAX ? NO_VERTEX : dists[v];
+        case 2:
+        {
+            uint16_t d = reinterpret_cast<const uint16_t *>(dists)[v];
+            return d == UINT16_MAX ? NO_VERTEX : d;
+        }
+        default:
+            return reinterpret_cast<const uint32_t *>(dists)[v];
+        }
+    }
+
+
+    /**
+     ** BfsSpill class:
+     **     Scratch file backing the arrays of all the BFS results of a run instead of
+     **     the heap (they are allocated there before their traversal). Each block is a
+     **     shared mapping of its own file region, so its pages can be written back and
+     **     dropped by the kernel under memory pressure. A released region is punched
+     **     out of the file and reused by the next block of the same size, so the file
+     **     follows the live results. The file is unlinked as soon as it is created and
+     **     disappears with the process.
+     **/
+
+    class BfsSpill
+    {
+        public:
+
+            BfsSpill(std::string filename);
+
+            std::shared_ptr<void> allocate(size_t size);
+
+        private:
+
+            struct SpillFile
+            {
+                int fd; // descriptor of the unlinked scratch file.
+                size_t file_size; // allocated size of the file (multiple of the page size).
+                std::mutex lock; // blocks are allocated and released from several threads.
+                std::vector<std::pair<size_t, size_t>> regions; // released regions (size, offset).
+
+                ~SpillFile();
+            };
+
+            std::shared_ptr<SpillFile> file; // shared with the deleters of the blocks in use.
+
+    };
+
+
+    /**
+     ** BfsBlockPool class:
+     **     Heap blocks of the BFS results of a run. A released block is kept in a free
+     **     list and given back to the next request of the same size (all the results of
+     **     a graph use the same few sizes), so steady-state traversals do not call the
+     **     allocator. The blocks are freed together when the pool and every block taken
+     **     from it are released.
+     **/
+
+    class BfsBlockPool
+    {
+        public:
+
+            BfsBlockPool();
+
+            std::shared_ptr<void> allocate(size_t size);
+
+        private:
+
+            struct FreeBlocks
+            {
+                std::mutex lock; // blocks are allocated and released from several threads.
+                std::vector<std::pair<size_t, void *>> blocks; // released blocks and their size.
+
+                ~FreeBlocks();
+            };
+
+            std::shared_ptr<FreeBlocks> free_blocks; // shared with the deleters of the blocks in use.
+
+    };
+
+
+    /**
+     ** BfsResult class:
+     **     Output of one BFS on a CSR graph, all ids are CSR internal ids.
+     **     Fathers are 32-bit, distances use 1, 2 or 4 bytes depending on the
+     **     eccentricity of the root. Unreached vertices have NO_VERTEX as father
+     **     and distance (and rank). The father of the root is the root itself.
+     **     order and ranks are only filled when the caller asks for them.
+     **/
+
+    class BfsResult
+    {
+        public:
+
+            uint32_t root = NO_VERTEX;
+            uint32_t reached_nb = 0; // number of reached vertices (root included).
+            uint32_t max_dist = 0; // eccentricity of the root in its component.
+            std::vector<uint32_t> order; // traversed vertices in BFS order (BFS_KEEP_ORDER).
+            std::vector<uint32_t> ranks; // rank of each vertex in order (BFS_KEEP_RANKS).
+
+            void allocate(uint32_t root, uint32_t vertices_nb, uint32_t max_dist, BfsSpill *spill = NULL,
+                    BfsBlockPool *blocks = NULL);
+            void set(uint32_t v, uint32_t father, uint32_t dist);
+            void place(uint32_t v, uint32_t father, uint32_t dist);
+            void widen(uint32_t dist, BfsSpill *spill = NULL, BfsBlockPool *blocks = NULL);
+            void release_fathers();
+            size_t memory_size() const;
+
+            // Getters:
+            uint32_t get_vertices_nb() const;
+            uint32_t father(uint32_t v) const;
+            uint32_t dist(uint32_t v) const;
+
+        private:
+
+            uint32_t vertices_nb = 0; // size of the arrays.
+            int dist_bytes = 4; // width of a distance.
+            uint32_t *fathers = NULL; // parent of each vertex in the BFS tree.
+            uint8_t *dists = NULL; // distance of each vertex, dist_bytes per vertex.
+            std::shared_ptr<void> fathers_storage; // heap block or file mapping holding fathers.
+            std::shared_ptr<void> dists_storage; // heap block or file mapping holding dists.
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline uint32_t BfsResult::get_vertices_nb() const
+    {
+        return this->vertices_nb;
+    }
+
+
+    inline uint32_t BfsResult::father(uint32_t v) const
+    {
+        return this->fathers[v];
+    }
+
+
+    inline uint32_t BfsResult::dist(uint32_t v) const
+    {
+        return load_dist(this->dists, this->dist_bytes, v);
+    }
+
+} // namespace Spanner
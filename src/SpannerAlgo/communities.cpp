@@ -0,0 +1,509 @@
+#include "communities.hpp"
+#include "spanner_algo.hpp"
+#include "run_report.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+
+
+namespace Spanner
+{
+
+    /**
+     ** CommunitiesHeader structure:
+     **     Header of a community cache file, followed by the community of each vertex
+     **     (uint32_t, igraph ids order). The graph is identified by its size and a hash
+     **     of its degree sequence, the communities by the Leiden parameters.
+     **/
+
+    struct CommunitiesHeader
+    {
+        char magic[COMMUNITIES_MAGIC_SIZE];
+        uint32_t vertices_nb;
+        uint32_t communities_nb;
+        uint64_t edges_nb;
+        uint64_t degrees_hash; // see degrees_hash().
+        double resolution;
+        double beta;
+        uint64_t seed; // seed of the igraph generator used by Leiden.
+    };
+
+
+    /**
+     ** degrees_hash():
+     **     params:  csr -> graph to identify.
+     **
+     **     Cheap fingerprint of the graph: FNV-1a hash of its degree sequence in igraph
+     **     ids order (independent of the CSR relabeling).
+     **/
+
+    static uint64_t degrees_hash(const Graph::CsrGraph &csr)
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (uint32_t v = 0; v < csr.get_vertices_nb(); v++)
+            hash = (hash ^ csr.degree(csr.to_internal(v))) * 0x100000001b3ULL;
+
+        return hash;
+    }
+
+
+    /**
+     ** leiden_header():
+     **     params:  csr -> graph of the communities.
+     **              communities_nb -> number of communities.
+     **
+     **     Header identifying the communities of csr computed by leiden_communities().
+     **/
+
+    static CommunitiesHeader leiden_header(const Graph::CsrGraph &csr, uint32_t communities_nb)
+    {
+        CommunitiesHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, COMMUNITIES_MAGIC, COMMUNITIES_MAGIC_SIZE);
+        header.vertices_nb = csr.get_vertices_nb();
+        header.communities_nb = communities_nb;
+        header.edges_nb = csr.get_edges_nb();
+        header.degrees_hash = degrees_hash(csr);
+        header.resolution = GAMMA_COMMUNITIES;
+        header.beta = LEIDEN_BETA;
+        header.seed = RNG_SEED;
+
+        return header;
+    }
+
+
+    /**
+     ** read_communities_cache():
+     **     params:  filename -> path of the cache file.
+     **              csr -> graph the communities must belong to.
+     **              res -> communities read from the file.
+     **
+     **     Return false when the file does not exist, was written for another graph
+     **     (number of vertices or edges, degree sequence) or with other Leiden parameters.
+     **/
+
+    static bool read_communities_cache(std::string filename, const Graph::CsrGraph &csr, Communities *res)
+    {
+        FILE *f = fopen(filename.c_str(), "rb");
+        if (!f)
+            return false;
+
+        CommunitiesHeader header;
+        CommunitiesHeader expected = leiden_header(csr, 0);
+        bool valid = fread(&header, sizeof(header), 1, f) == 1
+            && memcmp(header.magic, COMMUNITIES_MAGIC, COMMUNITIES_MAGIC_SIZE) == 0
+            && header.vertices_nb == expected.vertices_nb
+            && header.edges_nb == expected.edges_nb
+            && header.degrees_hash == expected.degrees_hash;
+
+        if (!valid)
+        {
+            fclose(f);
+            std::cerr << "Warning: ignoring the community cache " << filename
+                << " (not written for this graph)" << std::endl;
+            return false;
+        }
+
+        if (header.resolution != expected.resolution || header.beta != expected.beta || header.seed != expected.seed)
+        {
+            fclose(f);
+            std::cerr << "Warning: ignoring the community cache " << filename
+                << " (computed with other Leiden parameters)" << std::endl;
+            return false;
+        }
+
+        std::vector<uint32_t> membership(header.vertices_nb);
+        valid = fread(membership.data(), sizeof(uint32_t), membership.size(), f) == membership.size();
+        fclose(f);
+
+        if (!valid)
+        {
+            std::cerr << "Warning: ignoring the community cache " << filename
+                << " (truncated file)" << std::endl;
+            return false;
+        }
+
+        res->communities_nb = header.communities_nb;
+        res->membership.assign(header.vertices_nb, 0);
+        for (uint32_t v = 0; v < header.vertices_nb; v++)
+        {
+            if (membership[v] >= header.communities_nb)
+            {
+                std::cerr << "Warning: ignoring the community cache " << filename
+                    << " (bad community id)" << std::endl;
+                return false;
+            }
+            res->membership[csr.to_internal(v)] = membership[v];
+        }
+
+        return true;
+    }
+
+
+    /**
+     ** write_communities_cache():
+     **     params:  filename -> path of the cache file.
+     **              csr -> graph of the communities.
+     **              communities -> communities to save.
+     **/
+
+    static void write_communities_cache(std::string filename, const Graph::CsrGraph &csr, const Communities &communities)
+    {
+        FILE *f = fopen(filename.c_str(), "wb");
+        if (!f)
+        {
+            std::cerr << "Error: can't write the community cache " << filename << std::endl;
+            exit(1);
+        }
+
+        CommunitiesHeader header = leiden_header(csr, communities.communities_nb);
+
+        std::vector<uint32_t> membership(header.vertices_nb);
+        for (uint32_t v = 0; v < header.vertices_nb; v++)
+            membership[csr.to_original(v)] = communities.membership[v];
+
+        if (fwrite(&header, sizeof(header), 1, f) != 1
+            || fwrite(membership.data(), sizeof(uint32_t), membership.size(), f) != membership.size())
+        {
+            std::cerr << "Error: can't write the community cache " << filename << std::endl;
+            exit(1);
+        }
+
+        fclose(f);
+    }
+
+
+    /**
+     ** leiden_communities():
+     **     params:  g -> igraph version of csr.
+     **              csr -> graph whose vertices are partitioned.
+     **              cache_filename -> community cache file (empty for none).
+     **              res -> communities of the graph.
+     **
+     **     Compute communities of the graph with the Leiden algorithm (igraph generator
+     **     seeded with RNG_SEED). When a cache file is given, the communities are read
+     **     from it if it matches the graph and the parameters, otherwise they are
+     **     computed and saved into it for the next runs.
+     **/
+
+    void leiden_communities(igraph_t *g, const Graph::CsrGraph &csr, std::string cache_filename, Communities *res)
+    {
+        if (!cache_filename.empty() && read_communities_cache(cache_filename, csr, res))
+        {
+            std::cout << "Communities loaded from " << cache_filename << ": " << res->communities_nb
+                << " communities.\n";
+            return;
+        }
+
+        std::cout << "\n\t\t_______________\n\n" << "Computing graph communities ...\n";
+
+        igraph_integer_t communities_nb;
+        Graph::IgraphVector membership(igraph_vcount(g));
+
+        igraph_rng_seed(igraph_rng_default(), RNG_SEED);
+        igraph_community_leiden(g, NULL, NULL, GAMMA_COMMUNITIES, LEIDEN_BETA, 0, membership.get(), &communities_nb, NULL);
+
+        res->communities_nb = communities_nb;
+        res->membership.assign(csr.get_vertices_nb(), 0);
+        for (uint32_t v = 0; v < csr.get_vertices_nb(); v++)
+            res->membership[csr.to_internal(v)] = membership.data()[v];
+
+        std::cout << "The GCC of the graph is composed by " << communities_nb << " communities.\n";
+
+        if (!cache_filename.empty())
+            write_communities_cache(cache_filename, csr, *res);
+    }
+
+
+    /**
+     ** label_hash():
+     **     params:  label -> candidate label.
+     **              v -> vertex choosing its label.
+     **              iteration -> current iteration.
+     **              seed -> seed of the label propagation.
+     **
+     **     Seeded priority of a label, used to break the ties between labels. It
+     **     depends on the vertex and on the iteration, so the ties do not favor the
+     **     same label everywhere (which lets one label invade the whole graph).
+     **/
+
+    static uint64_t label_hash(uint32_t label, uint32_t v, int iteration, uint64_t seed)
+    {
+        uint64_t x = seed ^ (label * 0x9e3779b97f4a7c15ULL) ^ (v * 0xc2b2ae3d27d4eb4fULL)
+            ^ (static_cast<uint64_t>(iteration) * 0x165667b19e3779f9ULL);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+
+        return x ^ (x >> 31);
+    }
+
+
+    /**
+     ** label_propagation_communities():
+     **     params:  csr -> graph whose vertices are partitioned.
+     **              pool -> threads running the propagation.
+     **              seed -> seed of the vertex order and of the ties breaking.
+     **              threshold -> stop when less than threshold * vertices labels change.
+     **              res -> communities of the graph.
+     **
+     **     Each vertex starts with its own label, then repeatedly takes the most frequent
+     **     label of its neighbors (its current label is kept in case of tie, other ties
+     **     go to the highest seeded hash). The labels of the neighbors are sorted in a
+     **     degree sized buffer and counted by runs, so the memory does not grow with the
+     **     number of threads times the number of vertices. The vertices are shuffled once and cut into
+     **     LPA_CHUNKS chunks processed in parallel: inside a chunk the updates are
+     **     asynchronous (new labels of the chunk are read), between chunks they are
+     **     synchronous (labels of the previous iteration are read). The chunks do not
+     **     depend on the number of threads, so neither does the result.
+     **/
+
+    void label_propagation_communities(const Graph::CsrGraph &csr, Parallel::ThreadPool &pool, uint64_t seed,
+            double threshold, Communities *res)
+    {
+        std::cout << "\n\t\t_______________\n\n" << "Computing graph communities (label propagation) ...\n";
+
+        uint32_t vertices_nb = csr.get_vertices_nb();
+        std::vector<uint32_t> labels(vertices_nb);
+        std::iota(labels.begin(), labels.end(), 0);
+        std::vector<uint32_t> next = labels;
+
+        std::vector<uint32_t> order = labels;
+        std::mt19937_64 rng(seed);
+        std::shuffle(order.begin(), order.end(), rng);
+
+        size_t chunks_nb = std::max<size_t>(std::min<size_t>(LPA_CHUNKS, vertices_nb), 1);
+        std::vector<uint32_t> chunk_of(vertices_nb);
+        for (size_t chunk = 0; chunk < chunks_nb; chunk++)
+            for (size_t i = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+                    i < Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1); i++)
+                chunk_of[order[i]] = chunk;
+
+        // Neighbors labels of each thread (decoded neighbors of compressed graphs are
+        // replaced in place by their labels):
+        std::vector<std::vector<uint32_t>> buffers(pool.get_threads_nb(),
+                std::vector<uint32_t>(csr.get_max_degree()));
+
+        int iteration = 0;
+        uint64_t changed_nb = vertices_nb;
+
+        while (iteration < LPA_MAX_ITERATIONS && changed_nb > threshold * vertices_nb)
+        {
+            std::atomic<uint64_t> changed(0);
+
+            pool.run(chunks_nb, [&](size_t chunk, int thread_id)
+            {
+                uint32_t *neighbor_labels = buffers[thread_id].data();
+                uint64_t chunk_changed = 0;
+                uint64_t edges_nb = 0;
+
+                for (size_t i = Parallel::chunk_begin(vertices_nb, chunks_nb, chunk);
+                        i < Parallel::chunk_begin(vertices_nb, chunks_nb, chunk + 1); i++)
+                {
+                    uint32_t v = order[i];
+                    uint32_t degree = csr.degree(v);
+                    edges_nb += degree;
+
+                    const uint32_t *neighbors = csr.neighbors_of(v, neighbor_labels);
+                    for (uint32_t j = 0; j < degree; j++)
+                    {
+                        uint32_t u = neighbors[j];
+                        neighbor_labels[j] = (chunk_of[u] == chunk) ? next[u] : labels[u];
+                    }
+                    std::sort(neighbor_labels, neighbor_labels + degree);
+
+                    uint32_t current = next[v];
+                    uint32_t current_count = 0;
+                    uint32_t best = current;
+                    uint32_t best_count = 0;
+                    uint64_t best_hash = 0;
+
+                    for (uint32_t run = 0, end = 0; run < degree; run = end)
+                    {
+                        uint32_t label = neighbor_labels[run];
+                        while (end < degree && neighbor_labels[end] == label)
+                            end++;
+
+                        uint32_t count = end - run;
+                        if (label == current)
+                            current_count = count;
+                        if (count < best_count)
+                            continue;
+
+                        uint64_t hash = label_hash(label, v, iteration, seed);
+                        if (count > best_count || hash > best_hash)
+                        {
+                            best = label;
+                            best_count = count;
+                            best_hash = hash;
+                        }
+                    }
+
+                    if (current_count == best_count)
+                        best = current;
+
+                    if (best != current)
+                    {
+                        next[v] = best;
+                        chunk_changed++;
+                    }
+                }
+
+                changed += chunk_changed;
+                Report::count_edges(edges_nb);
+            });
+
+            labels = next;
+            changed_nb = changed;
+            iteration++;
+        }
+
+        // Number the remaining labels compactly:
+        std::vector<uint32_t> community_of_label(vertices_nb, NO_VERTEX);
+        res->communities_nb = 0;
+        res->membership.resize(vertices_nb);
+
+        for (uint32_t v = 0; v < vertices_nb; v++)
+        {
+            if (community_of_label[labels[v]] == NO_VERTEX)
+                community_of_label[labels[v]] = res->communities_nb++;
+            res->membership[v] = community_of_label[labels[v]];
+        }
+
+        std::cout << "The GCC of the graph is composed by " << res->communities_nb << " communities ("
+            << iteration << " iterations).\n";
+    }
+
+
+    /**
+     ** community_center():
+     **     params:  csr -> partitioned graph.
+     **              membership -> community of each vertex.
+     **              root -> vertex of the community where the BFS starts.
+     **              dists -> distances buffer, NO_VERTEX on the vertices of the community.
+     **              fathers -> parents buffer.
+     **              queue -> BFS queue buffer.
+     **              buffer -> decoded neighbors buffer (compressed graphs).
+     **
+     **     BFS from root restricted to the edges inside its community, then return the
+     **     middle of the path from root to the farthest vertex found. Each vertex is in
+     **     a single community, so the buffers are never reset and all the centers cost
+     **     one pass over the graph.
+     **/
+
+    static uint32_t community_center(const Graph::CsrGraph &csr, const std::vector<uint32_t> &membership, uint32_t root,
+            std::vector<uint32_t> &dists, std::vector<uint32_t> &fathers, std::vector<uint32_t> &queue,
+            std::vector<uint32_t> &buffer)
+    {
+        uint32_t community = membership[root];
+        uint64_t edges_nb = 0;
+
+        queue.clear();
+        queue.push_back(root);
+        dists[root] = 0;
+        fathers[root] = root;
+
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            uint32_t u = queue[head];
+            edges_nb += csr.degree(u);
+
+            const uint32_t *first = csr.neighbors_of(u, buffer.data());
+            for (const uint32_t *it = first; it != first + csr.degree(u); it++)
+            {
+                if (membership[*it] == community && dists[*it] == NO_VERTEX)
+                {
+                    dists[*it] = dists[u] + 1;
+                    fathers[*it] = u;
+                    queue.push_back(*it);
+                }
+            }
+        }
+
+        Report::count_edges(edges_nb);
+
+        uint32_t center = queue.back();
+        for (uint32_t step = 0; step < dists[queue.back()] / 2; step++)
+            center = fathers[center];
+
+        return center;
+    }
+
+
+    /**
+     ** community_representatives():
+     **     params:  csr -> partitioned graph.
+     **              communities -> communities of the vertices of csr.
+     **              mode -> choice of the representative inside a community.
+     **              seed -> seed of the RANDOM_VERTEX choice.
+     **              max_nb -> maximum number of representatives.
+     **
+     **     Return one representative (internal id) for each of the max_nb largest
+     **     communities, by decreasing community size (smallest id first in case of
+     **     tie). Sizes, highest degree vertices and random picks (reservoir sampling)
+     **     are found in a single pass over the vertices.
+     **/
+
+    std::vector<uint32_t> community_representatives(const Graph::CsrGraph &csr, const Communities &communities,
+            REPRESENTATIVE mode, uint64_t seed, size_t max_nb)
+    {
+        uint32_t vertices_nb = csr.get_vertices_nb();
+        const std::vector<uint32_t> &membership = communities.membership;
+        std::vector<uint32_t> sizes(communities.communities_nb, 0);
+        std::vector<uint32_t> best(communities.communities_nb, NO_VERTEX);
+        std::mt19937_64 rng(seed);
+
+        for (uint32_t v = 0; v < vertices_nb; v++)
+        {
+            uint32_t c = membership[v];
+            sizes[c]++;
+
+            if (mode == REPRESENTATIVE::RANDOM_VERTEX)
+            {
+                if (rng() % sizes[c] == 0)
+                    best[c] = v;
+            }
+            else if (best[c] == NO_VERTEX || csr.degree(v) > csr.degree(best[c]))
+                best[c] = v;
+        }
+
+        // Rank the non-empty communities by size:
+        std::vector<uint32_t> ranked;
+        for (uint32_t c = 0; c < communities.communities_nb; c++)
+            if (sizes[c] > 0)
+                ranked.push_back(c);
+
+        std::stable_sort(ranked.begin(), ranked.end(), [&sizes](uint32_t a, uint32_t b)
+        {
+            return sizes[a] > sizes[b];
+        });
+
+        if (ranked.size() > max_nb)
+            ranked.resize(max_nb);
+
+        std::vector<uint32_t> representatives;
+        representatives.reserve(ranked.size());
+
+        if (mode == REPRESENTATIVE::CENTRAL)
+        {
+            std::vector<uint32_t> dists(vertices_nb, NO_VERTEX);
+            std::vector<uint32_t> fathers(vertices_nb, NO_VERTEX);
+            std::vector<uint32_t> queue;
+            std::vector<uint32_t> buffer(csr.neighbors_buffer_size());
+
+            for (uint32_t c : ranked)
+                representatives.push_back(community_center(csr, membership, best[c], dists, fathers, queue, buffer));
+        }
+        else
+        {
+            for (uint32_t c : ranked)
+                representatives.push_back(best[c]);
+        }
+
+        return representatives;
+    }
+
+} // namespace Spanner
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <igraph.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+
+
+// Magic header of the community cache files (8 bytes, last byte is the format version):
+#define COMMUNITIES_MAGIC "VLSCOM\x02\x00"
+#define COMMUNITIES_MAGIC_SIZE 8
+
+// Randomness of the Leiden refinement step:
+#define LEIDEN_BETA 0.01
+
+// Label propagation: default fraction of changed labels below which it has converged,
+// maximum number of iterations and number of vertex chunks of an iteration:
+#define LPA_THRESHOLD 0.001
+#define LPA_MAX_ITERATIONS 50
+#define LPA_CHUNKS 1024
+
+
+namespace Spanner
+{
+
+    /**
+     ** REPRESENTATIVE enum:
+     **     Choice of the BFS root inside each community.
+     **         MAX_DEGREE -> highest degree vertex of the community.
+     **         CENTRAL -> middle of the longest shortest path found by a BFS inside the
+     **                    community from its highest degree vertex (approximate center).
+     **         RANDOM_VERTEX -> uniform random vertex of the community (seeded).
+     **/
+
+    enum REPRESENTATIVE
+    {
+        MAX_DEGREE,
+        CENTRAL,
+        RANDOM_VERTEX
+    };
+
+
+    /**
+     ** Communities structure:
+     **     Partition of the vertices of a CSR graph, ids are CSR internal ids.
+     **/
+
+    struct Communities
+    {
+        uint32_t communities_nb = 0; // number of communities (ids are in [0, communities_nb[).
+        std::vector<uint32_t> membership; // community of each vertex.
+    };
+
+
+    void leiden_communities(igraph_t *g, const Graph::CsrGraph &csr, std::string cache_filename, Communities *res);
+    void label_propagation_communities(const Graph::CsrGraph &csr, Parallel::ThreadPool &pool, uint64_t seed,
+            double threshold, Communities *res);
+    std::vector<uint32_t> community_representatives(const Graph::CsrGraph &csr, const Communities &communities,
+            REPRESENTATIVE mode, uint64_t seed, size_t max_nb);
+
+} // namespace Spanner
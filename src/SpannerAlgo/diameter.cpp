@@ -0,0 +1,112 @@
+#include "diameter.hpp"
+
+
+namespace Spanner
+{
+
+    /**
+     ** ifub_diameter():
+     **     params:  csr -> connected graph (internal ids).
+     **              engine -> BFS engine working on csr.
+     **
+     **     Exact diameter with the iFUB algorithm (Crescenzi et al.):
+     **         - a double sweep from the highest degree vertex gives a lower bound and a
+     **           long path, whose middle vertex u is taken as the BFS center.
+     **         - the levels of the BFS from u are read from the deepest one. Once the
+     **           eccentricities of all the vertices of level i and deeper are known, any
+     **           other pair is at distance at most 2 * (i - 1), so the search stops as
+     **           soon as the lower bound reaches this value.
+     **     The eccentricities of a level are computed in parallel by the engine. On
+     **     real-world graphs only a few levels, thus a few BFS, are needed.
+     **/
+
+    DiameterResult ifub_diameter(const Graph::CsrGraph &csr, BfsEngine &engine)
+    {
+        DiameterResult res;
+        uint32_t vertices_nb = csr.get_vertices_nb();
+
+        if (vertices_nb == 0)
+            return res;
+
+        // Double sweep: farthest vertex a from the highest degree vertex, then BFS from a.
+        uint32_t start = 0;
+        for (uint32_t v = 1; v < vertices_nb; v++)
+            if (csr.degree(v) > csr.degree(start))
+                start = v;
+
+        std::vector<uint32_t> eccs, farthest;
+        engine.eccentricities({start}, &eccs, &farthest);
+
+        std::vector<BfsResult> sweep;
+        engine.run({farthest[0]}, &sweep, BFS_KEEP_ORDER);
+        res.bfs_nb = 2;
+
+        BfsResult &from_a = sweep[0];
+        uint32_t end_x = from_a.root;
+        uint32_t end_y = from_a.order.back();
+        uint32_t lower = from_a.dist(end_y);
+
+        // Center u: middle of the path from a to its farthest vertex.
+        uint32_t u = end_y;
+        for (uint32_t step = 0; step < lower / 2; step++)
+            u = from_a.father(u);
+
+        std::vector<BfsResult> center;
+        engine.run({u}, &center, BFS_KEEP_ORDER);
+        res.bfs_nb++;
+
+        const std::vector<uint32_t> &order = center[0].order;
+        uint32_t level = center[0].max_dist;
+
+        if (level > lower)
+        {
+            lower = level;
+            end_x = u;
+            end_y = order.back();
+        }
+
+        // Fringes from the deepest level (order is sorted by distance).
+        size_t level_end = order.size();
+        std::vector<uint32_t> fringe;
+
+        while (lower < 2 * level)
+        {
+            size_t level_begin = level_end;
+            while (level_begin > 0 && center[0].dist(order[level_begin - 1]) == level)
+                level_begin--;
+
+            fringe.assign(order.begin() + level_begin, order.begin() + level_end);
+            engine.eccentricities(fringe, &eccs, &farthest);
+            res.bfs_nb += fringe.size();
+
+            for (size_t i = 0; i < fringe.size(); i++)
+            {
+                if (eccs[i] > lower)
+                {
+                    lower = eccs[i];
+                    end_x = fringe[i];
+                    end_y = farthest[i];
+                }
+            }
+
+            level_end = level_begin;
+            level--;
+        }
+
+        res.diameter = lower;
+
+        // Diametral path: walk up the BFS tree of one extremity.
+        if (end_x != from_a.root)
+        {
+            engine.run({end_x}, &sweep);
+            res.bfs_nb++;
+        }
+
+        for (uint32_t v = end_y; v != end_x; v = sweep[0].father(v))
+            res.path.push_back(csr.to_original(v));
+        res.path.push_back(csr.to_original(end_x));
+
+        return res;
+    }
+
+} // namespace Spanner
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+#include "bfs_engine.hpp"
+
+
+namespace Spanner
+{
+
+    /**
+     ** DiameterResult structure:
+     **     Exact diameter of a connected graph with one diametral path.
+     **/
+
+    struct DiameterResult
+    {
+        uint32_t diameter = 0; // length of the longest shortest path.
+        std::vector<uint32_t> path; // vertices of a diametral path (original ids of the CSR graph).
+        size_t bfs_nb = 0; // number of BFS traversals used.
+    };
+
+
+    DiameterResult ifub_diameter(const Graph::CsrGraph &csr, BfsEngine &engine);
+
+} // namespace Spanner
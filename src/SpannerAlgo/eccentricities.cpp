@@ -0,0 +1,199 @@
+#include "eccentricities.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+
+namespace Spanner
+{
+
+    /**
+     ** BoundingEccentricities class constructor:
+     **     params:  csr -> connected graph whose eccentricities are computed.
+     **              engine -> BFS engine working on csr.
+     **/
+
+    BoundingEccentricities::BoundingEccentricities(const Graph::CsrGraph &csr, BfsEngine &engine)
+        : csr(csr), engine(engine), bfs_nb(0)
+    {
+    }
+
+
+    /**
+     ** run():
+     **     Compute the eccentricity of every vertex. Pruned leaves take the eccentricity
+     **     of their representative at the end. The first root is the highest
+     **     degree vertex, then each BFS updates the bounds of the remaining candidates
+     **     and selects the next root in the same pass. Vertices not reached by a BFS
+     **     (other component) keep their bounds, so eccentricities are computed inside
+     **     each component.
+     **/
+
+    void BoundingEccentricities::run()
+    {
+        uint32_t vertices_nb = this->csr.get_vertices_nb();
+
+        this->eccentricities.assign(vertices_nb, NO_VERTEX);
+        this->lower.assign(vertices_nb, 0);
+        this->upper.assign(vertices_nb, NO_VERTEX);
+        this->candidates.clear();
+        this->positions.assign(vertices_nb, NO_VERTEX);
+        this->bfs_nb = 0;
+
+        if (vertices_nb == 0)
+            return;
+
+        // Pruning: the degree one neighbors of a vertex share the same eccentricity,
+        // only the first one stays a candidate and represents the others.
+        std::vector<uint32_t> representatives(vertices_nb, NO_VERTEX);
+        std::vector<uint32_t> buffer(this->csr.neighbors_buffer_size());
+        for (uint32_t u = 0; u < vertices_nb; u++)
+        {
+            uint32_t first_leaf = NO_VERTEX;
+            const uint32_t *first = this->csr.neighbors_of(u, buffer.data());
+            for (const uint32_t *it = first; it != first + this->csr.degree(u); it++)
+            {
+                if (this->csr.degree(*it) != 1 || *it == u)
+                    continue;
+
+                if (first_leaf == NO_VERTEX)
+                    first_leaf = *it;
+                else if (this->csr.degree(u) > 1)
+                    representatives[*it] = first_leaf;
+            }
+        }
+
+        for (uint32_t v = 0; v < vertices_nb; v++)
+        {
+            if (representatives[v] == NO_VERTEX)
+            {
+                this->positions[v] = this->candidates.size();
+                this->candidates.push_back(v);
+            }
+        }
+
+        uint32_t next = 0;
+        for (uint32_t v = 1; v < vertices_nb; v++)
+            if (this->csr.degree(v) > this->csr.degree(next))
+                next = v;
+
+        bool high_upper = true;
+
+        while (!this->candidates.empty())
+        {
+            uint32_t v = next;
+            uint32_t ecc_v = this->engine.distances(v, &this->dists);
+            this->bfs_nb++;
+
+            this->eccentricities[v] = ecc_v;
+            this->remove_candidate(v);
+
+            next = NO_VERTEX;
+            size_t i = 0;
+            while (i < this->candidates.size())
+            {
+                uint32_t w = this->candidates[i];
+                uint32_t d = this->dists[w];
+
+                if (d != NO_VERTEX)
+                {
+                    this->lower[w] = std::max(this->lower[w], std::max(ecc_v - d, d));
+                    this->upper[w] = std::min(this->upper[w], ecc_v + d);
+
+                    // the last candidate is moved at position i, so i is not incremented.
+                    if (this->lower[w] == this->upper[w])
+                    {
+                        this->eccentricities[w] = this->lower[w];
+                        this->remove_candidate(w);
+                        continue;
+                    }
+                }
+
+                if (next == NO_VERTEX || this->is_better(w, next, high_upper))
+                    next = w;
+                i++;
+            }
+
+            high_upper = !high_upper;
+        }
+
+        for (uint32_t v = 0; v < vertices_nb; v++)
+            if (representatives[v] != NO_VERTEX)
+                this->eccentricities[v] = this->eccentricities[representatives[v]];
+    }
+
+
+    /**
+     ** remove_candidate():
+     **     params:  v -> candidate to remove.
+     **
+     **     Remove v in constant time by moving the last candidate at its position.
+     **/
+
+    void BoundingEccentricities::remove_candidate(uint32_t v)
+    {
+        uint32_t pos = this->positions[v];
+        uint32_t last = this->candidates.back();
+
+        this->candidates[pos] = last;
+        this->positions[last] = pos;
+        this->candidates.pop_back();
+        this->positions[v] = NO_VERTEX;
+    }
+
+
+    /**
+     ** is_better():
+     **     params:  v -> candidate to compare.
+     **              best -> current selected candidate.
+     **              high_upper -> select on the largest upper bound (true) or on the
+     **                            smallest lower bound (false).
+     **
+     **     Selection heuristic of the next BFS root, ties broken by the highest degree.
+     **/
+
+    bool BoundingEccentricities::is_better(uint32_t v, uint32_t best, bool high_upper) const
+    {
+        if (high_upper && this->upper[v] != this->upper[best])
+            return this->upper[v] > this->upper[best];
+
+        if (!high_upper && this->lower[v] != this->lower[best])
+            return this->lower[v] < this->lower[best];
+
+        return this->csr.degree(v) > this->csr.degree(best);
+    }
+
+
+    /**
+     ** stats():
+     **     Summarize the computed eccentricities: distribution, mean, variance,
+     **     radius and diameter.
+     **/
+
+    EccentricityStats BoundingEccentricities::stats() const
+    {
+        EccentricityStats res;
+        res.bfs_nb = this->bfs_nb;
+
+        if (this->eccentricities.empty())
+            return res;
+
+        res.radius = *std::min_element(this->eccentricities.begin(), this->eccentricities.end());
+        res.diameter = *std::max_element(this->eccentricities.begin(), this->eccentricities.end());
+        res.distribution.assign(static_cast<size_t>(res.diameter) + 1, 0);
+
+        for (uint32_t ecc : this->eccentricities)
+        {
+            res.distribution[ecc]++;
+            res.mean += ecc;
+        }
+        res.mean /= this->eccentricities.size();
+
+        for (uint32_t ecc : this->eccentricities)
+            res.variance += (ecc - res.mean) * (ecc - res.mean);
+        res.variance /= this->eccentricities.size();
+
+        return res;
+    }
+
+} // namespace Spanner
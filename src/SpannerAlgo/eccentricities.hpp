@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+#include "bfs_engine.hpp"
+
+
+namespace Spanner
+{
+
+    /**
+     ** EccentricityStats structure:
+     **     Summary of the exact eccentricities of a connected graph.
+     **/
+
+    struct EccentricityStats
+    {
+        std::vector<uint64_t> distribution; // number of vertices of each eccentricity value.
+        double mean = 0.0; // mean eccentricity.
+        double variance = 0.0; // variance of the eccentricities.
+        uint32_t radius = 0; // smallest eccentricity.
+        uint32_t diameter = 0; // largest eccentricity.
+        size_t bfs_nb = 0; // number of BFS traversals used to compute them.
+    };
+
+
+    /**
+     ** BoundingEccentricities class:
+     **     Exact eccentricities of all the vertices of a connected CSR graph with the
+     **     BoundingDiameters algorithm (Takes & Koster). After a BFS from v, each
+     **     candidate w gets the bounds
+     **         max(ecc(v) - d(v, w), d(v, w)) <= ecc(w) <= ecc(v) + d(v, w)
+     **     and leaves the candidates when both bounds meet. Candidates are kept in a
+     **     dense array with the position of each vertex, so a removal is a swap with
+     **     the last candidate. The next BFS root alternates between the candidate with
+     **     the largest upper bound and the one with the smallest lower bound (highest
+     **     degree first in case of tie), which usually leaves only a few BFS to do.
+     **     As in the original algorithm, the leaves hanging on the same vertex are
+     **     pruned to a single candidate.
+     **/
+
+    class BoundingEccentricities
+    {
+        public:
+
+            BoundingEccentricities(const Graph::CsrGraph &csr, BfsEngine &engine);
+
+            void run();
+            EccentricityStats stats() const;
+
+            // Getters:
+            const std::vector<uint32_t> &get_eccentricities() const;
+            size_t get_bfs_nb() const;
+
+        private:
+
+            const Graph::CsrGraph &csr; // connected graph (internal ids).
+            BfsEngine &engine; // BFS engine working on csr.
+
+            std::vector<uint32_t> eccentricities; // eccentricity of each vertex (NO_VERTEX until known).
+            std::vector<uint32_t> lower; // lower bound of each eccentricity.
+            std::vector<uint32_t> upper; // upper bound of each eccentricity.
+            std::vector<uint32_t> candidates; // vertices whose eccentricity is unknown.
+            std::vector<uint32_t> positions; // position of each vertex in candidates (NO_VERTEX if removed).
+            std::vector<uint32_t> dists; // distances of the last BFS.
+            size_t bfs_nb; // number of BFS traversals done.
+
+            // Methods:
+            void remove_candidate(uint32_t v);
+            bool is_better(uint32_t v, uint32_t best, bool high_upper) const;
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline const std::vector<uint32_t> &BoundingEccentricities::get_eccentricities() const
+    {
+        return this->eccentricities;
+    }
+
+
+    inline size_t BoundingEccentricities::get_bfs_nb() const
+    {
+        return this->bfs_nb;
+    }
+
+} // namespace Spanner
@@ -0,0 +1,107 @@
+#include "edge_accumulator.hpp"
+
+#include <iostream>
+
+
+namespace Spanner
+{
+
+    /**
+     ** EdgeAccumulator class constructor:
+     **     params: vertices_nb -> number of vertices of the spanner.
+     **             expected_edges -> number of edges expected, used to size the buffers.
+     **/
+
+    EdgeAccumulator::EdgeAccumulator(uint32_t vertices_nb, size_t expected_edges)
+        : vertices_nb(vertices_nb), edge_set(expected_edges), trees_nb(0), last_new_edges(0)
+    {
+        this->edges.reserve(2 * expected_edges);
+    }
+
+
+    /**
+     ** add_edge():
+     **     params: u, v -> extremities of the edge (internal ids).
+     **
+     **     Accept the edge (u, v) in the spanner. Return false if it was already accepted.
+     **/
+
+    bool EdgeAccumulator::add_edge(uint32_t u, uint32_t v)
+    {
+        if (!this->edge_set.insert(u, v))
+            return false;
+
+        this->edges.push_back(u);
+        this->edges.push_back(v);
+
+        return true;
+    }
+
+
+    /**
+     ** merge_tree():
+     **     params: bfs -> BFS result whose tree is merged.
+     **
+     **     Accept every (father, vertex) edge of the BFS tree not yet in the spanner.
+     **     Return the number of new edges.
+     **/
+
+    size_t EdgeAccumulator::merge_tree(const BfsResult &bfs)
+    {
+        size_t new_edges = 0;
+
+        for (uint32_t v = 0; v < bfs.get_vertices_nb(); v++)
+        {
+            // skip the root and unreached vertices because they don't have a parent.
+            if (v == bfs.root || bfs.father(v) == NO_VERTEX)
+                continue;
+
+            if (this->add_edge(bfs.father(v), v))
+                new_edges++;
+        }
+
+        this->trees_nb++;
+        this->last_new_edges = new_edges;
+
+        return new_edges;
+    }
+
+
+    /**
+     ** count_new_tree_edges():
+     **     params: bfs -> BFS result to check.
+     **
+     **     Return the number of BFS tree edges which are not yet in the spanner.
+     **/
+
+    size_t EdgeAccumulator::count_new_tree_edges(const BfsResult &bfs) const
+    {
+        size_t new_edges = 0;
+
+        for (uint32_t v = 0; v < bfs.get_vertices_nb(); v++)
+            if (v != bfs.root && bfs.father(v) != NO_VERTEX && !this->edge_set.contains(bfs.father(v), v))
+                new_edges++;
+
+        return new_edges;
+    }
+
+
+    /**
+     ** build_igraph():
+     **     params: csr -> CSR graph giving the original ids of the internal ids.
+     **
+     **     Create the spanner igraph structure in a single construction from the
+     **     accepted edges, with original vertex ids.
+     **/
+
+    Graph::IgraphPtr EdgeAccumulator::build_igraph(const Graph::CsrGraph &csr) const
+    {
+        Graph::IgraphVector span_edges(this->edges.size());
+
+        for (size_t i = 0; i < this->edges.size(); i++)
+            span_edges.data()[i] = csr.to_original(this->edges[i]);
+
+        return Graph::create_igraph(span_edges, this->vertices_nb);
+    }
+
+} // namespace Spanner
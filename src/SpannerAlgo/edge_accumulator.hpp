@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <igraph.h>
+
+#include "csr_graph.hpp"
+#include "bfs_engine.hpp"
+#include "edge_set.hpp"
+
+
+namespace Spanner
+{
+
+    /**
+     ** EdgeAccumulator class:
+     **     Collect the distinct edges accepted in the spanner (CSR internal ids) in a flat
+     **     buffer, and materialize the spanner igraph structure once at the end of the
+     **     construction. Counters give the spanner state during the construction.
+     **/
+
+    class EdgeAccumulator
+    {
+        public:
+
+            EdgeAccumulator(uint32_t vertices_nb, size_t expected_edges = 0);
+
+            bool add_edge(uint32_t u, uint32_t v);
+            size_t merge_tree(const BfsResult &bfs);
+            size_t count_new_tree_edges(const BfsResult &bfs) const;
+            Graph::IgraphPtr build_igraph(const Graph::CsrGraph &csr) const;
+
+            // Getters:
+            uint32_t get_vertices_nb() const;
+            size_t get_edges_nb() const;
+            size_t get_trees_nb() const;
+            size_t get_last_new_edges() const;
+            const std::vector<uint32_t> &get_edges() const;
+
+        private:
+
+            uint32_t vertices_nb; // number of vertices of the spanner.
+            EdgeSet edge_set; // accepted edges, for deduplication.
+            std::vector<uint32_t> edges; // accepted edges (u_0, v_0, u_1, v_1, ...).
+            size_t trees_nb; // number of merged BFS trees.
+            size_t last_new_edges; // number of edges added by the last merged tree.
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline uint32_t EdgeAccumulator::get_vertices_nb() const
+    {
+        return this->vertices_nb;
+    }
+
+
+    inline size_t EdgeAccumulator::get_edges_nb() const
+    {
+        return this->edges.size() / 2;
+    }
+
+
+    inline size_t EdgeAccumulator::get_trees_nb() const
+    {
+        return this->trees_nb;
+    }
+
+
+    inline size_t EdgeAccumulator::get_last_new_edges() const
+    {
+        return this->last_new_edges;
+    }
+
+
+    inline const std::vector<uint32_t> &EdgeAccumulator::get_edges() const
+    {
+        return this->edges;
+    }
+
+} // namespace Spanner
@@ -0,0 +1,117 @@
+#include "edge_set.hpp"
+
+#include <algorithm>
+
+
+namespace Spanner
+{
+
+    /**
+     ** EdgeSet class constructor:
+     **     params: expected_edges -> number of edges expected, used to size the table
+     **                               and avoid rehashing.
+     **/
+
+    EdgeSet::EdgeSet(size_t expected_edges)
+        : count(0)
+    {
+        size_t capacity = 16;
+        while (capacity < 2 * expected_edges)
+            capacity *= 2;
+
+        this->slots.assign(capacity, EMPTY_EDGE_KEY);
+        this->mask = capacity - 1;
+    }
+
+
+    /**
+     ** insert():
+     **     params: u, v -> extremities of the edge.
+     **
+     **     Add the edge (u, v) to the set. Return true if the edge was not already in it.
+     **/
+
+    bool EdgeSet::insert(uint32_t u, uint32_t v)
+    {
+        if (2 * (this->count + 1) > this->slots.size())
+            this->grow();
+
+        return this->insert_key(edge_key(u, v));
+    }
+
+
+    /**
+     ** contains():
+     **     params: u, v -> extremities of the edge.
+     **
+     **     Return true if the edge (u, v) is in the set.
+     **/
+
+    bool EdgeSet::contains(uint32_t u, uint32_t v) const
+    {
+        uint64_t key = edge_key(u, v);
+
+        for (uint64_t pos = edge_hash(key) & this->mask; this->slots[pos] != EMPTY_EDGE_KEY; pos = (pos + 1) & this->mask)
+            if (this->slots[pos] == key)
+                return true;
+
+        return false;
+    }
+
+
+    /**
+     ** clear():
+     **     Remove all edges and keep the table capacity.
+     **/
+
+    void EdgeSet::clear()
+    {
+        std::fill(this->slots.begin(), this->slots.end(), EMPTY_EDGE_KEY);
+        this->count = 0;
+    }
+
+
+    /**
+     ** insert_key():
+     **     params: key -> canonical edge key.
+     **
+     **     Linear probing insertion of key, the table must have a free slot.
+     **/
+
+    bool EdgeSet::insert_key(uint64_t key)
+    {
+        uint64_t pos = edge_hash(key) & this->mask;
+
+        while (this->slots[pos] != EMPTY_EDGE_KEY)
+        {
+            if (this->slots[pos] == key)
+                return false;
+
+            pos = (pos + 1) & this->mask;
+        }
+
+        this->slots[pos] = key;
+        this->count++;
+
+        return true;
+    }
+
+
+    /**
+     ** grow():
+     **     Double the table size and reinsert all keys.
+     **/
+
+    void EdgeSet::grow()
+    {
+        std::vector<uint64_t> old_slots(2 * this->slots.size(), EMPTY_EDGE_KEY);
+        old_slots.swap(this->slots);
+        this->mask = this->slots.size() - 1;
+        this->count = 0;
+
+        for (uint64_t key : old_slots)
+            if (key != EMPTY_EDGE_KEY)
+                this->insert_key(key);
+    }
+
+} // namespace Spanner
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+// Marker of an empty slot of the edge set (key of the impossible edge (NO_VERTEX, NO_VERTEX)):
+#define EMPTY_EDGE_KEY UINT64_MAX
+
+
+namespace Spanner
+{
+
+    /**
+     ** EdgeSet class:
+     **     Compact open-addressing hash set of undirected edges. An edge is stored as
+     **     its canonical 64-bit key (min(u, v) << 32 | max(u, v)) in a power of two
+     **     table with linear probing, kept at most half full.
+     **/
+
+    class EdgeSet
+    {
+        public:
+
+            EdgeSet(size_t expected_edges = 0);
+
+            bool insert(uint32_t u, uint32_t v);
+            bool contains(uint32_t u, uint32_t v) const;
+            void clear();
+
+            // Getters:
+            size_t size() const;
+
+        private:
+
+            std::vector<uint64_t> slots; // hash table of edge keys.
+            uint64_t mask; // slots size - 1.
+            size_t count; // number of stored edges.
+
+            // Methods:
+            void grow();
+            bool insert_key(uint64_t key);
+
+    };
+
+
+    /**
+     ** Getters implementation:
+     **/
+
+    inline size_t EdgeSet::size() const
+    {
+        return this->count;
+    }
+
+
+    /**
+     ** edge_key():
+     **     Return the canonical key of the undirected edge (u, v).
+     **/
+
+    inline uint64_t edge_key(uint32_t u, uint32_t v)
+    {
+        return (u < v) ? (static_cast<uint64_t>(u) << 32 | v) : (static_cast<uint64_t>(v) << 32 | u);
+    }
+
+
+    /**
+     ** edge_hash():
+     **     Mix the bits of an edge key (splitmix64 finalizer).
+     **/
+
+    inline uint64_t edge_hash(uint64_t key)
+    {
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+
+        return key;
+    }
+
+} // namespace Spanner
@@ -1,67 +1,70 @@
 #include "spanner_algo.hpp"
+#include "run_report.hpp"
+
+#include <random>
 
 
 namespace Spanner
 {
 
     /**
-     ** vector_mean():
-     **     params:  vec -> vector to compute the mean value.
+     ** select_points_randomly():
+     **     params:  vertices_nb -> number of vertices of the graph.
+     **              bfs_nb -> number of points to select.
      **
-     **     Compute mean value of int vector.
+     **     Select bfs_nb distinct random vertices from graph (all of them if the
+     **     graph is smaller).
      **/
 
-    static float vector_mean(std::vector<int> vec)
+    static std::vector<int> select_points_randomly(igraph_integer_t vertices_nb, int bfs_nb)
     {
-        float mean = 0.0f;
-
-        if (!vec.empty())
-            mean = std::accumulate(vec.begin(), vec.end(), 0.0) / vec.size();
-
-        return mean;
-    }
-
-
-    /**
-     ** vector_var():
-     **     params:  vec -> vector to compute the variance value.
-     **
-     **     Compute variance value of int vector.
-     **/
+        igraph_rng_t *rng_generator = igraph_rng_default();
+        igraph_rng_init(rng_generator, &igraph_rngtype_glibc2);
+        igraph_rng_seed(rng_generator, RNG_SEED);
 
-    static float vector_var(std::vector<int> vec)
-    {
-        std::vector<float> vec_f = std::vector<float>(vec.begin(), vec.end());
-        float mean = vector_mean(vec);
-        float variance = 0.0f;
+        std::vector<int> select_pts = std::vector<int>();
+        std::vector<bool> selected(vertices_nb, false);
 
-        std::for_each(vec_f.begin(), vec_f.end(), [mean](float& elt) { elt -= mean;});
+        while (static_cast<igraph_integer_t>(select_pts.size()) < std::min<igraph_integer_t>(bfs_nb, vertices_nb))
+        {
+            int v = igraph_rng_get_integer(rng_generator, 0, vertices_nb - 1);
+            if (selected[v])
+                continue;
 
-        if (!vec_f.empty())
-            variance = std::inner_product(vec_f.begin(), vec_f.end(), vec_f.begin(), 0.0) / vec.size();
+            selected[v] = true;
+            select_pts.push_back(v);
+        }
 
-        return variance;
+        return select_pts;
     }
 
 
     /**
-     ** select_points_randomly():
-     **     params:  g -> model based graph for span building.
+     ** select_points_high_degree():
+     **     params:  csr -> CSR graph.
+     **              bfs_nb -> number of points to select.
      **
-     **     Select 15 random vertices from graph.
+     **     Select the bfs_nb highest degree vertices (smallest id first in case of tie),
+     **     by decreasing degree. Only the selected vertices are sorted.
      **/
 
-    static std::vector<int> select_points_randomly(igraph_t *g)
+    static std::vector<int> select_points_high_degree(const Graph::CsrGraph &csr, int bfs_nb)
     {
-        igraph_rng_t *rng_generator = igraph_rng_default();
-        igraph_rng_init(rng_generator, &igraph_rngtype_glibc2);
-        igraph_rng_seed(rng_generator, RNG_SEED);
+        std::vector<uint32_t> vertices(csr.get_vertices_nb());
+        std::iota(vertices.begin(), vertices.end(), 0);
 
-        std::vector<int> select_pts = std::vector<int>();
-        igraph_integer_t vertices_nb = igraph_vcount(g);
+        auto higher_degree = [&csr](uint32_t a, uint32_t b)
+        {
+            return csr.degree(a) > csr.degree(b) || (csr.degree(a) == csr.degree(b) && csr.to_original(a) < csr.to_original(b));
+        };
 
-        for (int i = 0; i < 15; i++)
-            select_pts.push_back(igraph_rng_get_integer(rng_generator, 0, vertices_nb));
+        size_t selected_nb = std::min(vertices.size(), static_cast<size_t>(std::max(bfs_nb, 0)));
+        std::nth_element(vertices.begin(), vertices.begin() + selected_nb, vertices.end(), higher_degree);
+        std::sort(vertices.begin(), vertices.begin() + selected_nb, higher_degree);
+
+        std::vector<int> select_pts;
+        for (size_t i = 0; i < selected_nb; i++)
+            select_pts.push_back(csr.to_original(vertices[i]));
 
         return select_pts;
     }
@@ -70,44 +73,50 @@ namespace Spanner
     /**
      ** select_points_from_communities():
      **     params:  g -> model based graph for span building.
+     **              csr -> CSR version of g.
+     **              params -> spanner parameters (strategy, number of BFS, representative choice,
+     **                        cache, label propagation tuning).
+     **              pool -> threads running the label propagation.
      **
-     **     Compute communities of the graph based on Leiden algorithm, then select one
-     **     representative from each community. The result is all the selected vertices
-     **     of the graph.
+     **     Compute communities of the graph based on Leiden algorithm (COMMUNITY strategy)
+     **     or on label propagation (LABEL_PROPAGATION strategy), then select one
+     **     representative from each of the bfs_nb largest communities (see communities.hpp).
+     **     The result is the selected vertices (igraph ids), largest community first. With
+     **     less communities than bfs_nb, the highest degree vertices not yet selected
+     **     complete the sources.
      **/
 
-    static std::vector<int> select_points_from_communities(igraph_t *g)
+    static std::vector<int> select_points_from_communities(igraph_t *g, const Graph::CsrGraph &csr, const SpannerParams &params,
+            Parallel::ThreadPool &pool)
     {
-        std::cout << "\n\t\t_______________\n\n" << "Computing graph communities ...\n";
-        // Compute communities
-        igraph_integer_t communities_nb;
-        igraph_vector_t membership;
-        igraph_vector_init(&membership, igraph_vcount(g));
+        Communities communities;
+        if (params.strat == BFS_STRATEGY::LABEL_PROPAGATION)
+            label_propagation_communities(csr, pool, params.lp_seed, params.lp_threshold, &communities);
+        else
+            leiden_communities(g, csr, params.communities_cache, &communities);
 
-        igraph_community_leiden(g, NULL, NULL, GAMMA_COMMUNITIES, 0.01, 0, &membership, &communities_nb, NULL);
+        std::vector<uint32_t> representatives = community_representatives(csr, communities, params.representative,
+                params.representative_seed, std::max(params.bfs_nb, 0));
 
-        // Add communities representative (first encountered) as source points
-        std::vector<int> select_pts = std::vector<int>();
-        std::vector<int> encountered_clusters = std::vector<int>();
-        int membership_index = 0;
+        std::vector<int> select_pts;
+        for (uint32_t v : representatives)
+            select_pts.push_back(csr.to_original(v));
 
-        while (select_pts.size() < communities_nb)
+        if (static_cast<int>(select_pts.size()) < params.bfs_nb)
         {
-            int cluster = VECTOR(membership)[membership_index];
+            std::vector<bool> selected(csr.get_vertices_nb(), false);
+            for (uint32_t v : representatives)
+                selected[v] = true;
 
-            if (std::find(encountered_clusters.begin(), encountered_clusters.end(), cluster) == encountered_clusters.end())
-            {
-                encountered_clusters.push_back(cluster);
-                select_pts.push_back(membership_index);
-            }
+            size_t communities_nb = select_pts.size();
+            for (int v : select_points_high_degree(csr, params.bfs_nb))
+                if (!selected[csr.to_internal(v)] && static_cast<int>(select_pts.size()) < params.bfs_nb)
+                    select_pts.push_back(v);
 
-            membership_index++;
+            std::cout << "Only " << communities_nb << " communities: " << select_pts.size() - communities_nb
+                << " highest degree vertices complete the BFS sources.\n";
         }
 
-        std::cout << "The GCC of the graph is composed by " << communities_nb
-            << " communities." << "\n\t\t_______________\n\n" << "Computing graph communities ..."
-            << std::endl;
-
         return select_pts;
     }
 
@@ -115,25 +124,36 @@ namespace Spanner
     /**
      ** select_bfs_points():
      **     params:  g -> model based graph for span building.
-     **              strat -> strategy of points selection.
-     **              bfs_nb -> number of BFS done, this is the number of sources points.
+     **              csr -> CSR version of g.
+     **              params -> spanner parameters: strategy of points selection, number of
+     **                        BFS done (the number of sources points) and strategy tuning.
+     **              pool -> threads used by the parallel strategies.
      **
-     **     Select vertices from the g graph according to a strat strategy defined
+     **     Select vertices from the g graph according to the strategy defined
      **     in BFS_STRATEGY enum. Then call the according strategy selection.
+     **     FARTHEST_POINT roots depend on the previous BFS: none is returned, they are
+     **     selected by pre_compute_bfs().
      **/
 
-    static std::vector<int> select_bfs_points(igraph_t *g, BFS_STRATEGY strat, int bfs_nb)
+    std::vector<int> select_bfs_points(igraph_t *g, const Graph::CsrGraph &csr, const SpannerParams &params,
+            Parallel::ThreadPool &pool)
     {
+        Report::ScopedPhase phase("select");
         std::vector<int> select_pts;
 
-        switch(strat)
+        switch(params.strat)
         {
         case BFS_STRATEGY::RANDOM:
-            select_pts = select_points_randomly(g);
+            select_pts = select_points_randomly(csr.get_vertices_nb(), params.bfs_nb);
+            break;
+        case BFS_STRATEGY::HIGH_DEGREE:
+            select_pts = select_points_high_degree(csr, params.bfs_nb);
+            break;
+        case BFS_STRATEGY::FARTHEST_POINT:
             break;
         case BFS_STRATEGY::COMMUNITY:
-            select_pts = select_points_from_communities(g);
-            select_pts.resize(bfs_nb);
+        case BFS_STRATEGY::LABEL_PROPAGATION:
+            select_pts = select_points_from_communities(g, csr, params, pool);
             break;
         }
 
@@ -142,313 +162,691 @@ namespace Spanner
 
 
     /**
-     ** initialize_spanner():
-     **     params:  g -> model based graph for span building.
+     ** igraph_pre_compute_bfs():
+     **     params:  g -> original graph where we will do BFS.
+     **              csr -> CSR version of g, giving the internal ids of the results.
+     **              roots -> internal ids of the BFS roots.
+     **              bfs_vec -> list of BFS results, one for each root.
      **
-     **     Initialize span igraph structure for span building.
-     **     The begin graph is composed by all g graph vertices but without edges.
+     **     Reference backend: compute each BFS with igraph_bfs() sequentially, then
+     **     convert the igraph father and distance vectors into a BfsResult.
      **/
 
-    static igraph_t *initialize_spanner(igraph_t *g)
+    static void igraph_pre_compute_bfs(igraph_t *g, const Graph::CsrGraph &csr, const std::vector<uint32_t> &roots, std::vector<BfsResult> *bfs_vec)
     {
-        igraph_t *span = (igraph_t *)malloc(sizeof(igraph_t));
-        igraph_empty(span, igraph_vcount(g), IGRAPH_UNDIRECTED);
+        uint32_t vertices_nb = csr.get_vertices_nb();
+        bfs_vec->resize(roots.size());
 
-        return span;
+        Graph::IgraphVector order, rank, father, dist;
+
+        for (size_t i = 0; i < roots.size(); i++)
+        {
+            if (!Report::is_quiet())
+                std::cout << "compute BFS nb: " << i << " ...\n";
+
+            igraph_integer_t root = csr.to_original(roots[i]);
+            igraph_bfs(g, root, NULL, IGRAPH_ALL, false, NULL, order.get(), rank.get(), father.get(), NULL, NULL, dist.get(), NULL, NULL);
+
+            // unreached vertices are not in the order vector (negative or NaN entries).
+            long reached_nb = 0;
+            while (reached_nb < igraph_vector_size(order.get()) && order.data()[reached_nb] >= 0)
+                reached_nb++;
+
+            BfsResult &bfs = (*bfs_vec)[i];
+            uint64_t edges_nb = 0;
+            bfs.allocate(roots[i], vertices_nb, dist.data()[static_cast<igraph_integer_t>(order.data()[reached_nb - 1])]);
+
+            for (long k = 0; k < reached_nb; k++)
+            {
+                igraph_integer_t v = order.data()[k];
+                uint32_t internal_v = csr.to_internal(v);
+
+                bfs.set(internal_v, (v == root) ? roots[i] : csr.to_internal(father.data()[v]), dist.data()[v]);
+                edges_nb += csr.degree(internal_v);
+            }
+
+            Report::count_edges(edges_nb);
+            Report::count_bfs();
+        }
     }
 
 
     /**
-     ** build_bfs_edges():
-     **     params:  vparents -> list of parent vertice index according to index in list.
-     **              root_id -> vertice id of the BFS root.
+     ** run_backend():
+     **     params:  g -> original graph (igraph backend).
+     **              engine -> BFS engine working on csr.
+     **              csr -> CSR version of the graph where we will do BFS.
+     **              roots -> internal ids of the BFS roots.
+     **              bfs_vec -> BFS results, one for each root.
+     **              params -> spanner parameters (BFS backend and its tuning).
      **
-     **     Build the list of BFS edges following this structure:
-     **         (parent_01, node_01, parent_02, node_02, ...)
+     **     Compute the BFS from roots with the selected backend. A single root gains
+     **     nothing from the bit-parallel kernel, it is done by a queue BFS.
      **/
 
-    static igraph_vector_t build_bfs_edges(igraph_vector_t vparents, igraph_integer_t root_id)
+    static void run_backend(igraph_t *g, BfsEngine &engine, const Graph::CsrGraph &csr, const std::vector<uint32_t> &roots,
+            std::vector<BfsResult> *bfs_vec, const SpannerParams &params)
     {
-        int vparents_size = igraph_vector_size(&vparents);
+        switch (params.bfs_backend)
+        {
+        case BFS_BACKEND::IGRAPH:
+            igraph_pre_compute_bfs(g, csr, roots, bfs_vec);
+            break;
+        case BFS_BACKEND::QUEUE:
+            engine.run(roots, bfs_vec);
+            break;
+        case BFS_BACKEND::BIT_PARALLEL:
+            if (roots.size() == 1)
+                engine.run(roots, bfs_vec);
+            else
+                engine.run_bit_parallel(roots, bfs_vec);
+            break;
+        case BFS_BACKEND::DIRECTION_OPTIMIZING:
+            engine.run_direction_optimizing(roots, bfs_vec, params.do_alpha, params.do_beta);
+            break;
+        }
+    }
 
-        igraph_vector_t bfs_edges;
-        igraph_vector_init(&bfs_edges, 2 * vparents_size);
 
-        for (int i = 0; i < vparents_size; i++)
-        {
-            // skip the root check because root doesn't have a parent.
-            if (i == root_id)
-                continue;
+    /**
+     ** highest_degree_vertex():
+     **     params:  csr -> non empty CSR graph.
+     **
+     **     Return the highest degree vertex (smallest internal id in case of tie).
+     **/
 
-            VECTOR(bfs_edges)[2 * i] = VECTOR(vparents)[i]; // parent
-            VECTOR(bfs_edges)[2 * i + 1] = i; // child
+    static uint32_t highest_degree_vertex(const Graph::CsrGraph &csr)
+    {
+        uint32_t res = 0;
+        for (uint32_t v = 1; v < csr.get_vertices_nb(); v++)
+            if (csr.degree(v) > csr.degree(res))
+                res = v;
 
-            // manage root case by swapping parent/node order.
-            // So, we have two (root, root_child) into bfs_edges.
-            if (VECTOR(vparents)[i] == root_id)
-            {
-                VECTOR(bfs_edges)[2 * root_id] = i; // child
-                VECTOR(bfs_edges)[2 * root_id + 1] = root_id; // root
-            }
+        return res;
+    }
+
+
+    /**
+     ** update_nearest_root():
+     **     params:  nearest_root_dist -> distance of each vertex to its nearest root.
+     **              bfs -> BFS from a new root.
+     **
+     **     Take the new root into account and return the vertex farthest from all the
+     **     roots (k-center next root). Unreached vertices keep NO_VERTEX, so other
+     **     components are selected first.
+     **/
+
+    static uint32_t update_nearest_root(std::vector<uint32_t> *nearest_root_dist, const BfsResult &bfs)
+    {
+        uint32_t farthest = 0;
+        for (uint32_t v = 0; v < nearest_root_dist->size(); v++)
+        {
+            (*nearest_root_dist)[v] = std::min((*nearest_root_dist)[v], bfs.dist(v));
+            if ((*nearest_root_dist)[v] > (*nearest_root_dist)[farthest])
+                farthest = v;
         }
 
-        return bfs_edges;
+        return farthest;
     }
 
 
     /**
-     ** remove_similar_edges():
-     **     params:  g -> original graph containing last added edges.
-     **              bfs_edges -> new BFS edges vector to clean.
+     ** farthest_point_bfs():
+     **     params:  g -> original graph (igraph backend).
+     **              engine -> BFS engine working on csr.
+     **              csr -> CSR version of the graph where we will do BFS.
+     **              bfs_vec -> BFS results, in selection order.
+     **              params -> spanner parameters (number of BFS, BFS backend).
      **
-     **     Remove all edges from bfs_edges that are found in the original g graph.
+     **     Greedy k-center selection (Gonzalez): the first root is the highest degree
+     **     vertex, each next root is the vertex farthest from all the previous roots.
+     **     The distance to the nearest root of each vertex is updated from the BFS tree
+     **     of each new root, so the selection costs no traversal besides the BFS of the
+     **     spanner. The roots depend on each other, so the BFS are done one by one
+     **     (bit-parallel backend falls back on queue BFS).
      **/
 
-    static void remove_similar_edges(igraph_t *g, igraph_vector_t *bfs_edges)
+    static void farthest_point_bfs(igraph_t *g, BfsEngine &engine, const Graph::CsrGraph &csr, std::vector<BfsResult> *bfs_vec, const SpannerParams &params)
     {
-        igraph_vector_t cleaned_edges;
-        int bfs_edges_size = igraph_vector_size(bfs_edges);
-        igraph_vector_init(&cleaned_edges, bfs_edges_size);
+        std::vector<uint32_t> nearest_root_dist(csr.get_vertices_nb(), NO_VERTEX);
+        std::vector<BfsResult> res;
 
-        igraph_integer_t edge_eid;
-        int cleaned_index = 0;
+        bfs_vec->clear();
+        if (csr.get_vertices_nb() == 0)
+            return;
+
+        uint32_t root = highest_degree_vertex(csr);
 
-        for (int i = 0; i < bfs_edges_size; i += 2)
+        while (static_cast<int>(bfs_vec->size()) < params.bfs_nb)
         {
-            igraph_integer_t from = VECTOR(*bfs_edges)[i];
-            igraph_integer_t to = VECTOR(*bfs_edges)[i + 1];
+            run_backend(g, engine, csr, std::vector<uint32_t>(1, root), &res, params);
+            bfs_vec->push_back(std::move(res[0]));
 
-            igraph_get_eid(g, &edge_eid, from, to, false, false);
+            root = update_nearest_root(&nearest_root_dist, bfs_vec->back());
 
-            // Edge between from and to doesn't exist
-            if (edge_eid == -1)
-            {
-                VECTOR(cleaned_edges)[cleaned_index++] = from;
-                VECTOR(cleaned_edges)[cleaned_index++] = to;
-            }
+            // all the vertices are roots:
+            if (nearest_root_dist[root] == 0)
+                break;
         }
-
-        *bfs_edges = cleaned_edges;
     }
 
 
     /**
      ** pre_compute_bfs():
      **     params:  g -> original graph where we will do BFS.
-     **              sources_pt -> list of vertice id considered as root in BFS.
-     **              orders_vec -> list of list each containing traversed vertices id in BFS order,
-     **                            for each root vertice.
-     **              fathers_vec -> list of list each containing traversed vertices parent id in BFS order,
-     **                             for each root vertice.
-     **              ranks_vec -> list of list each containing traversed vertices ranks in BFS (ie. depth value),
-     **                           for each root vertice.
-     **              dists_vec -> list of list each containing traversed vertices distance from the BFS root,
-     **                           for each root vertice.
-     **              bfs_nb -> number of BFS to do.
+     **              engine -> BFS engine working on the CSR version of the graph.
+     **              csr -> CSR version of the graph where we will do BFS.
+     **              sources_pt -> list of vertice id (original ids) considered as root in BFS.
+     **              bfs_vec -> list of BFS results (fathers and distances), one for each
+     **                         root vertice.
+     **              params -> spanner parameters (number of BFS to do, BFS backend and its tuning).
      **
-     **     Compute all Breadth-First Searches from sources_pt and store results into parameters vectors.
+     **     Compute all Breadth-First Searches from sources_pt with the selected backend
+     **     and store results into bfs_vec. With the FARTHEST_POINT strategy, sources_pt is
+     **     ignored and the roots are selected along the BFS.
      **/
 
-    static void pre_compute_bfs(igraph_t *g, std::vector<int> sources_pt, std::vector<igraph_vector_t> *orders_vec, std::vector<igraph_vector_t> *fathers_vec, std::vector<igraph_vector_t> *ranks_vec, std::vector<igraph_vector_t> *dists_vec, int bfs_nb)
+    void pre_compute_bfs(igraph_t *g, BfsEngine &engine, const Graph::CsrGraph &csr, const std::vector<int> &sources_pt, std::vector<BfsResult> *bfs_vec, const SpannerParams &params)
     {
-        for (int i = 0; i < std::min(bfs_nb, static_cast<int>(sources_pt.size())); i++)
+        Report::ScopedPhase phase("bfs");
+
+        if (params.strat == BFS_STRATEGY::FARTHEST_POINT)
         {
-            std::cout << "compute BFS nb: " << i << " ..." << std::endl;
+            std::cout << "compute " << params.bfs_nb << " farthest point BFS ...\n";
+            farthest_point_bfs(g, engine, csr, bfs_vec, params);
+            return;
+        }
 
-            // Initialize BFS storage vectors
-            igraph_vector_init(&((*orders_vec)[i]), 0);
-            igraph_vector_init(&((*fathers_vec)[i]), 0);
-            igraph_vector_init(&((*dists_vec)[i]), 0);
-            igraph_vector_init(&((*ranks_vec)[i]), 0);
+        std::vector<uint32_t> roots;
+        for (int i = 0; i < std::min(params.bfs_nb, static_cast<int>(sources_pt.size())); i++)
+            roots.push_back(csr.to_internal(sources_pt[i]));
 
-            igraph_bfs(g, sources_pt[i], NULL, IGRAPH_ALL, false, NULL, &((*orders_vec)[i]), &((*ranks_vec)[i]), &((*fathers_vec)[i]), NULL, NULL, &((*dists_vec)[i]), NULL, NULL);
-        }
+        std::cout << "compute " << roots.size() << " BFS ...\n";
+
+        run_backend(g, engine, csr, roots, bfs_vec, params);
     }
 
 
     /**
      ** merge_bfs():
-     **     params:  g -> spanner graph we want to complete with new BFS.
-     **              bfs_vertices -> vertices of the new BFS to merge.
-     **              bfs_dist -> vertices layer numbers according to bfs_vertices order.
-     **              bfs_father -> parent of each edges into new BFS search.
+     **     params:  span_edges -> accumulator of the spanner edges.
+     **              bfs -> BFS result to merge.
+     **
+     **     Merge the BFS tree represented by bfs into the spanner edges. Only the tree edges
+     **     not yet accepted are added, so the spanner never contains parallel edges and the
+     **     merge costs about the size of the tree. The igraph spanner is built once all
+     **     trees are merged.
+     **/
+
+    static void merge_bfs(EdgeAccumulator *span_edges, const BfsResult &bfs)
+    {
+        span_edges->merge_tree(bfs);
+    }
+
+
+    /**
+     ** edge_budget():
+     **     params:  csr -> CSR graph of the spanner.
+     **              params -> spanner parameters (max_edges or max_edge_ratio).
+     **
+     **     Return the maximum number of edges of the spanner.
+     **/
+
+    uint64_t edge_budget(const Graph::CsrGraph &csr, const SpannerParams &params)
+    {
+        if (params.max_edges > 0)
+            return params.max_edges;
+
+        return params.max_edge_ratio * csr.get_edges_nb();
+    }
+
+
+    /**
+     ** stop_before_merge():
+     **     params:  span_edges -> accumulator of the spanner edges.
+     **              bfs -> BFS result going to be merged.
+     **              budget -> maximum number of edges of the spanner.
+     **              min_gain -> minimum fraction of new edges in the tree.
+     **              gain -> fraction of the tree edges not yet in the spanner.
      **
-     **     Merge the BFS represented by the three last parameters into the g graph.
+     **     Stopping condition of the spanner growth: the tree would exceed the edge
+     **     budget, or it adds too few edges to be worth merging (marginal gain).
      **/
 
-    static void merge_bfs(igraph_t *g, igraph_vector_t bfs_vertices, igraph_vector_t bfs_dist, igraph_vector_t bfs_father)
+    static bool stop_before_merge(const EdgeAccumulator &span_edges, const BfsResult &bfs, uint64_t budget, double min_gain, double *gain)
     {
-        igraph_vector_t bfs_edges;
-        bfs_edges = build_bfs_edges(bfs_father, VECTOR(bfs_vertices)[0]);
+        size_t new_edges_nb = span_edges.count_new_tree_edges(bfs);
+        *gain = bfs.reached_nb > 1 ? static_cast<double>(new_edges_nb) / (bfs.reached_nb - 1) : 0.0;
 
-        // First merge case, just take all edges from first BFS
-        if (!igraph_ecount(g))
+        if (span_edges.get_edges_nb() + new_edges_nb > budget)
         {
-            igraph_add_edges(g, &bfs_edges, 0);
-            return;
+            std::cout << "Stopping condition is reached: edge budget (" << budget << " edges).\n";
+            return true;
+        }
+
+        if (span_edges.get_trees_nb() > 0 && *gain < min_gain)
+        {
+            std::cout << "Stopping condition is reached: marginal gain " << *gain << " < " << min_gain << ".\n";
+            return true;
         }
 
-        // Merge BFS with current g graph
-        //remove_similar_edges(g, &bfs_edges);
-        igraph_add_edges(g, &bfs_edges, 0);
+        return false;
     }
 
 
     /**
-     ** first_existing_source():
-     **     params:  g_vertices -> spanner graph we want to complete with new BFS.
-     **              sources_pt -> list of sources vertices from BFS strategy.
-     **              index_in_sources_pt -> index of last selected point vertice.
-     **
-     **     Find the first source vertice index of sources_pt that is unused and is not removed of
-     **     g_vertices during last function calls. Unused means that we never return this index by
-     **     this function during last calls, and not removed means that was not erased by computing
-     **     bounding eccentricities.
-     **     In fact, this function returns the required vertice index and increments the index_in_sources_pt.
+     ** merge_bfs_trees():
+     **     params:  span_edges -> accumulator of the spanner edges.
+     **              csr -> CSR graph traversed by the BFS.
+     **              bfs_vec -> BFS results to merge, in merging order.
+     **              params -> spanner parameters (edge budget and minimum gain).
      **
+     **     Merge the BFS trees one after the other until the stopping condition: the
+     **     spanner would exceed its edge budget (80% of the graph edges by default)
+     **     or the tree adds too few edges. Return the number of merged trees.
      **/
 
-    static int first_existing_source(std::vector<int> g_vertices, std::vector<int> sources_pt, int *index_in_sources_pt)
+    size_t merge_bfs_trees(EdgeAccumulator *span_edges, const Graph::CsrGraph &csr, const std::vector<BfsResult> &bfs_vec,
+            const SpannerParams &params)
     {
-        // we not use the last returned value
-        (*index_in_sources_pt)++;
+        Report::ScopedPhase phase("merge");
+        bool verbose = !Report::is_quiet();
+        uint64_t budget = edge_budget(csr, params);
+        double gain;
 
-        std::vector<int>::iterator res_it;
+        for (int i = 0 ; i < static_cast<int>(bfs_vec.size()); i++)
+        {
+            if (verbose)
+                std::cout << "\nSpanner building: BFS number " << i << " is merging ..." << '\n';
 
-        while ((res_it = std::find(g_vertices.begin(), g_vertices.end(), sources_pt[*index_in_sources_pt])) == g_vertices.end())
-            (*index_in_sources_pt)++;
+            if (stop_before_merge(*span_edges, bfs_vec[i], budget, params.min_gain, &gain))
+                break;
 
-        // return value store into res_it iterator (ie. the first available source vertice index)
-        return *res_it;
+            merge_bfs(span_edges, bfs_vec[i]);
+            if (verbose)
+                std::cout << "Spanner is composed by: " << span_edges->get_edges_nb() << " edges.\n"
+                    << "merge is done." << '\n';
+        }
+
+        return span_edges->get_trees_nb();
     }
 
 
     /**
-     ** bounding_eccentricities():
-     **     params:  g -> spanner graph we want to complete with new BFS.
-     **              sources_pt -> list of vertices index according to BFS sources
-     **                            points selection
-     **              dists_vec -> list of vertices distance from BFS roots.
-     **              ranks_vec -> list of vertices ranks in associated BFS roots.
+     ** StretchLandmark structure:
+     **     Merged tree used by estimate_stretch(): its root and the distances from it
+     **     to the sampled vertices (NO_VERTEX if unreached).
+     **/
+
+    struct StretchLandmark
+    {
+        uint32_t root;
+        std::vector<uint32_t> dists;
+    };
+
+
+    /**
+     ** sample_vertices():
+     **     params:  vertices_nb -> number of vertices of the graph.
      **
-     **     Return the list of all eccentricities associated to each vertices in g graph.
-     **     The algorithm is based on Takes & Koster implementation.
+     **     Return STRETCH_ESTIMATE_SAMPLES vertices drawn with RNG_SEED (all of them in
+     **     a smaller graph), the same for every tree of the run.
      **/
 
-    static std::vector<int> bounding_eccentricities(igraph_t *g, std::vector<int> sources_pt, std::vector<igraph_vector_t> dists_vec, std::vector<igraph_vector_t> ranks_vec)
+    static std::vector<uint32_t> sample_vertices(uint32_t vertices_nb)
     {
-        int vertices_nb = igraph_vcount(g);
-        std::vector<int> g_vertices = std::vector<int>(vertices_nb);
-        std::iota(g_vertices.begin(), g_vertices.end(), 0); // fill g_vertices with int from 0 to vertices_nb
+        std::vector<uint32_t> samples;
+        if (vertices_nb <= STRETCH_ESTIMATE_SAMPLES)
+        {
+            samples.resize(vertices_nb);
+            std::iota(samples.begin(), samples.end(), 0);
+            return samples;
+        }
 
-        // define eccentricities vectors
-        std::vector<int> eps = std::vector<int>(vertices_nb); // eccentricities list
-        std::vector<int> eps_l = std::vector<int>(vertices_nb); // lower bound eccentricities list
-        std::vector<int> eps_u = std::vector<int>(vertices_nb); // upper bound eccentricities list
+        std::mt19937_64 generator(RNG_SEED);
+        std::uniform_int_distribution<uint32_t> distribution(0, vertices_nb - 1);
+        for (size_t i = 0; i < STRETCH_ESTIMATE_SAMPLES; i++)
+            samples.push_back(distribution(generator));
 
-        // set to default value
-        std::fill(eps.begin(), eps.end(), 0);
-        std::fill(eps_l.begin(), eps_l.end(), std::numeric_limits<int>::min());
-        std::fill(eps_u.begin(), eps_u.end(), std::numeric_limits<int>::max());
+        return samples;
+    }
 
-        // define index of source vertice selected to compute eccentricity
-        int source_pt_index = 0;
-        int cur_vertice;
 
-        while (!g_vertices.empty())
+    /**
+     ** estimate_stretch():
+     **     params:  landmarks -> first merged trees (see StretchLandmark).
+     **              samples -> sampled vertices.
+     **              bfs -> BFS from a new root r, not merged yet.
+     **
+     **     The spanner contains the BFS tree of each landmark root l, so
+     **         d_S(r, v) <= d(r, l) + d(l, v)
+     **     where d(r, l) is read in the new BFS. Return the mean over the sampled vertices
+     **     v reached from r of the smallest of these bounds divided by d(r, v): an upper
+     **     estimate of the mean stretch of the spanner from r, in O(samples * landmarks).
+     **/
+
+    static double estimate_stretch(const std::vector<StretchLandmark> &landmarks, const std::vector<uint32_t> &samples,
+            const BfsResult &bfs)
+    {
+        double sum = 0.0;
+        uint64_t pairs_nb = 0;
+
+        for (size_t i = 0; i < samples.size(); i++)
         {
-            std::cout << g_vertices.size() << std::endl;
+            uint32_t dist = bfs.dist(samples[i]);
+            if (dist == 0 || dist == NO_VERTEX)
+                continue;
 
-            // select a based vertice to compute eccentricity, according to BFS strategy (communities, etc ...)
-            cur_vertice = first_existing_source(g_vertices, sources_pt, &source_pt_index);
-            igraph_vs_t ecc_help_vs;
-            igraph_vs_1(&ecc_help_vs, cur_vertice);
+            uint64_t bound = UINT64_MAX;
+            for (const StretchLandmark &landmark : landmarks)
+                if (bfs.dist(landmark.root) != NO_VERTEX && landmark.dists[i] != NO_VERTEX)
+                    bound = std::min(bound, static_cast<uint64_t>(bfs.dist(landmark.root)) + landmark.dists[i]);
 
+            if (bound == UINT64_MAX)
+                continue;
+
+            sum += static_cast<double>(bound) / dist;
+            pairs_nb++;
+        }
+
+        return pairs_nb > 0 ? sum / pairs_nb : 1.0;
+    }
 
-            // compute eccentricity of cur_vector
-            igraph_vector_t ecc_help_results;
-            igraph_vector_init(&ecc_help_results, 0);
-            igraph_eccentricity(g, &ecc_help_results, ecc_help_vs, IGRAPH_ALL);
-            eps[cur_vertice] = VECTOR(ecc_help_results)[0];
 
+    /**
+     ** grow_spanner():
+     **     params:  g -> original graph (igraph backend).
+     **              engine -> BFS engine working on csr.
+     **              csr -> CSR graph for span building.
+     **              sources_pt -> BFS roots (original ids), ignored by FARTHEST_POINT.
+     **              span_edges -> accumulator of the spanner edges.
+     **              params -> spanner parameters (number of BFS, backend, stopping conditions).
+     **              pool -> threads of the engine, giving the batch size.
+     **
+     **     Incremental version of pre_compute_bfs() + merge_bfs_trees(): the BFS are
+     **     computed by batches of one per thread (one at a time for FARTHEST_POINT) and
+     **     merged until the stopping condition, so at most a batch of BFS is wasted.
+     **     Each merged tree prints its marginal gain and the running mean of the estimated
+     **     stretch before each merge (see estimate_stretch()), only the distances of the
+     **     first trees to the sampled vertices are kept. Return the number of merged trees.
+     **/
 
-            for (int v : g_vertices)
+    size_t grow_spanner(igraph_t *g, BfsEngine &engine, const Graph::CsrGraph &csr, const std::vector<int> &sources_pt,
+            EdgeAccumulator *span_edges, const SpannerParams &params, Parallel::ThreadPool &pool)
+    {
+        Report::ScopedPhase phase("grow");
+        bool verbose = !Report::is_quiet();
+        bool farthest_point = params.strat == BFS_STRATEGY::FARTHEST_POINT;
+        uint64_t budget = edge_budget(csr, params);
+
+        std::vector<uint32_t> roots;
+        for (int v : sources_pt)
+            roots.push_back(csr.to_internal(v));
+
+        std::vector<uint32_t> nearest_root_dist;
+        uint32_t next_root = NO_VERTEX;
+        if (farthest_point && csr.get_vertices_nb() > 0)
+        {
+            nearest_root_dist.assign(csr.get_vertices_nb(), NO_VERTEX);
+            next_root = highest_degree_vertex(csr);
+        }
+
+        size_t batch_size = farthest_point ? 1 : pool.get_threads_nb();
+        std::vector<uint32_t> samples = sample_vertices(csr.get_vertices_nb());
+        std::vector<StretchLandmark> landmarks;
+        std::vector<BfsResult> batch_res;
+        size_t computed_nb = 0;
+        double stretch_sum = 0.0;
+        size_t estimates_nb = 0;
+        bool stop = false;
+
+        while (!stop && static_cast<int>(computed_nb) < params.bfs_nb)
+        {
+            std::vector<uint32_t> batch;
+            if (farthest_point)
             {
-                int v_bfs_rank = VECTOR(ranks_vec[source_pt_index])[v];
-                int dist_v_cur = VECTOR(dists_vec[source_pt_index])[v_bfs_rank];
-                eps_l[cur_vertice] = std::max(eps_l[cur_vertice], std::max(eps[v] - dist_v_cur, dist_v_cur));
-                eps_u[cur_vertice] = std::min(eps_u[cur_vertice], eps[v] + dist_v_cur);
+                if (next_root != NO_VERTEX)
+                    batch.push_back(next_root);
+            }
+            else
+            {
+                for (size_t i = computed_nb; i < roots.size() && i < computed_nb + batch_size
+                        && static_cast<int>(i) < params.bfs_nb; i++)
+                    batch.push_back(roots[i]);
+            }
+
+            if (batch.empty())
+                break;
+
+            run_backend(g, engine, csr, batch, &batch_res, params);
+            computed_nb += batch.size();
 
-                if (eps_l[cur_vertice] == eps_u[cur_vertice])
+            for (BfsResult &bfs : batch_res)
+            {
+                double gain;
+                if (stop_before_merge(*span_edges, bfs, budget, params.min_gain, &gain))
+                {
+                    stop = true;
+                    break;
+                }
+
+                if (!landmarks.empty())
                 {
-                    eps[cur_vertice] = eps_l[cur_vertice];
-                    // erase cur_vertice of the vertices vectors
-                    g_vertices.erase(std::find(g_vertices.begin(), g_vertices.end(), v));
+                    stretch_sum += estimate_stretch(landmarks, samples, bfs);
+                    estimates_nb++;
+                }
+
+                merge_bfs(span_edges, bfs);
+
+                if (verbose)
+                    std::cout << "Spanner building: BFS number " << span_edges->get_trees_nb() - 1 << " merged: gain "
+                        << gain << ", mean estimated stretch before merge "
+                        << (estimates_nb > 0 ? stretch_sum / estimates_nb : 1.0) << ", spanner edges "
+                        << span_edges->get_edges_nb() << ".\n";
+
+                if (farthest_point)
+                {
+                    next_root = update_nearest_root(&nearest_root_dist, bfs);
+                    if (nearest_root_dist[next_root] == 0)
+                        next_root = NO_VERTEX;
+                }
+
+                if (landmarks.size() < STRETCH_ESTIMATE_LANDMARKS)
+                {
+                    StretchLandmark landmark;
+                    landmark.root = bfs.root;
+                    for (uint32_t v : samples)
+                        landmark.dists.push_back(bfs.dist(v));
+                    landmarks.push_back(std::move(landmark));
                 }
             }
         }
 
-        return eps;
+        std::cout << "Incremental spanner: " << span_edges->get_trees_nb() << " trees merged out of "
+            << computed_nb << " BFS, " << span_edges->get_edges_nb() << " edges, mean estimated stretch "
+            << (estimates_nb > 0 ? stretch_sum / estimates_nb : 1.0) << ".\n";
+
+        return span_edges->get_trees_nb();
     }
 
 
     /**
      ** spanner_graph():
      **     params:  g -> model based graph for span building.
-     **              strat -> BFS root selection strategy.
-     **              bfs_nb -> number of BFS done.
+     **              params -> spanner parameters (BFS root selection strategy, number of BFS done,
+     **                        vertices ordering of the CSR graph, BFS backend).
+     **              pool -> threads used by the BFS engine.
      **
      **     The current algorithm select some points of the graph to perform BFS (Breadth-first search)
      **     and merge these output graphs. These operations result on a light sparse version of the graph,
-     **     this is the graph spanner.
+     **     this is the graph spanner. BFS are done on a CSR copy of g built once, with
+     **     compressed neighbors lists if params.compressed is set.
      **/
 
-    igraph_t *spanner_graph(igraph_t *g, BFS_STRATEGY strat, int bfs_nb)
+    Graph::IgraphPtr spanner_graph(igraph_t *g, const SpannerParams &params, Parallel::ThreadPool &pool)
     {
-        std::cout << "\n\t_______________________________\n\n" << "Computing very light spanner ...\n";
+        // Build the cache-friendly CSR version of g used by traversals
+        Report::ScopedPhase csr_phase("csr");
+        Graph::CsrGraph csr(g, params.ordering);
+        if (params.compressed)
+            csr.compress(pool);
+        csr_phase.stop();
+
+        return spanner_graph(csr, params, pool, g);
+    }
+
 
+    /**
+     ** bfs_merge_spanner():
+     **     params:  csr -> CSR graph for span building.
+     **              params -> spanner parameters (BFS root selection strategy, number of BFS done,
+     **                        BFS backend, stopping conditions).
+     **              pool -> threads used by the BFS engine.
+     **              g -> igraph version of csr (community strategy and igraph backend).
+     **              span_edges -> accumulator receiving the spanner edges.
+     **
+     **     Merge the BFS trees of the selected roots.
+     **/
+
+    static void bfs_merge_spanner(const Graph::CsrGraph &csr, const SpannerParams &params, Parallel::ThreadPool &pool,
+            igraph_t *g, EdgeAccumulator *span_edges)
+    {
         // selection of source points for BFS
-        std::vector<int> sources_pt = select_bfs_points(g, strat, bfs_nb);
+        std::vector<int> sources_pt = select_bfs_points(g, csr, params, pool);
+
+        // BFS results are allocated in a scratch file when asked (its regions are reused)
+        std::unique_ptr<BfsSpill> spill;
+        if (!params.bfs_spill.empty())
+            spill.reset(new BfsSpill(params.bfs_spill));
+
+        BfsEngine engine(csr, pool);
+        engine.set_spill(spill.get());
+
+        if (params.incremental)
+        {
+            // Compute and merge the BFS trees as long as they are needed
+            grow_spanner(g, engine, csr, sources_pt, span_edges, params, pool);
+        }
+        else
+        {
+            // Pre-compute all the BFS trees
+            std::vector<BfsResult> bfs_vec;
+            pre_compute_bfs(g, engine, csr, sources_pt, &bfs_vec, params);
+
+            // for each source points, merge its BFS tree to span until the stopping condition.
+            merge_bfs_trees(span_edges, csr, bfs_vec, params);
+        }
+    }
+
 
-        // Initialize span with all edges but no vertices
-        igraph_t *span = initialize_spanner(g);
+    /**
+     ** additive_spanner():
+     **     params:  csr -> CSR graph for span building.
+     **              params -> spanner parameters (heavy degree threshold, BFS backend).
+     **              pool -> threads used by the BFS engine.
+     **              g -> igraph version of csr (igraph backend).
+     **              span_edges -> accumulator receiving the spanner edges.
+     **
+     **     Additive +2 spanner (Aingworth, Chekuri, Indyk and Motwani): keep the edges of
+     **     the light vertices (degree below the threshold), cover the heavy vertices with
+     **     clusters around dominating centers, and merge the BFS tree of each center. A
+     **     shortest path u ~> v either only has edges with a light extremity, which are all
+     **     kept, or goes through a heavy vertex x adjacent to a center c, and the tree of
+     **     c gives d_S(u, v) <= d(c, u) + d(c, v) <= d(u, v) + 2. The BFS are computed by
+     **     batches of ADDITIVE_BFS_BATCH centers with the selected backend, then merged.
+     **/
+
+    static void additive_spanner(const Graph::CsrGraph &csr, const SpannerParams &params, Parallel::ThreadPool &pool,
+            igraph_t *g, EdgeAccumulator *span_edges)
+    {
+        Report::ScopedPhase phase("additive");
+        bool verbose = !Report::is_quiet();
+
+        uint32_t threshold = heavy_degree_threshold(csr, params.degree_threshold);
+        size_t light_nb = add_light_edges(csr, threshold, span_edges);
+        std::vector<uint32_t> centers = dominating_centers(csr, threshold);
+
+        std::cout << "Additive spanner: " << light_nb << " edges of vertices of degree < " << threshold << ", "
+            << centers.size() << " cluster centers to traverse.\n";
 
-        // Initialize eccentricity vector
-        //std::vector<int>  ecc_vector;
+        // Without heavy vertex all the edges are light: the spanner is a copy of the GCC
+        if (centers.empty())
+            std::cerr << "Warning: no vertex of degree >= " << threshold << ", the additive spanner keeps all the "
+                << "GCC edges (lower --degree-threshold to sparsify it).\n";
 
-        // Pre-compute bfs in order to have distance for boundaries eccentricities algorithm
-        std::vector<igraph_vector_t> orders_vec = std::vector<igraph_vector_t>(sources_pt.size());
-        std::vector<igraph_vector_t> fathers_vec = std::vector<igraph_vector_t>(sources_pt.size());
-        std::vector<igraph_vector_t> dists_vec = std::vector<igraph_vector_t>(sources_pt.size());
-        std::vector<igraph_vector_t> ranks_vec = std::vector<igraph_vector_t>(sources_pt.size());
+        std::unique_ptr<BfsSpill> spill;
+        if (!params.bfs_spill.empty())
+            spill.reset(new BfsSpill(params.bfs_spill));
 
-        pre_compute_bfs(g, sources_pt, &orders_vec, &fathers_vec, &ranks_vec, &dists_vec, bfs_nb);
+        BfsEngine engine(csr, pool);
+        engine.set_spill(spill.get());
+        std::vector<BfsResult> batch_res;
 
-        /* for each source points, compute BFS and merge it to span, compute difference of up/down bounding excentricity,
-           compute mean value and variance. */
-        for (int i = 0 ; i < sources_pt.size(); i++)
+        for (size_t first = 0; first < centers.size(); first += ADDITIVE_BFS_BATCH)
         {
-            std::cout << "\nSpanner building: BFS number " << i << " is merging ..." << '\n';
+            std::vector<uint32_t> batch(centers.begin() + first,
+                    centers.begin() + std::min(centers.size(), first + ADDITIVE_BFS_BATCH));
 
-            if ((0.8 * igraph_ecount(g)) < (igraph_ecount(span) + (igraph_vector_size(&(fathers_vec[i])) * 2)))
-            {
-                std::cout << "Stopping condition is reached." << std::endl;
-                break;
-            }
+            run_backend(g, engine, csr, batch, &batch_res, params);
+            for (const BfsResult &bfs : batch_res)
+                merge_bfs(span_edges, bfs);
 
-            merge_bfs(span, orders_vec[i], dists_vec[i], fathers_vec[i]);
-            std::cout << "Spanner is composed by: " << igraph_ecount(span) << " edges.\n" 
-                << "merge is done." << '\n';
+            if (verbose)
+                std::cout << "Spanner building: " << first + batch.size() << " / " << centers.size()
+                    << " center trees merged, spanner edges " << span_edges->get_edges_nb() << ".\n";
+        }
+
+        std::cout << "Additive spanner: " << span_edges->get_edges_nb() << " edges (additive stretch <= 2).\n";
+    }
 
-            //std::cout << "Computing bounding eccentricities ..." << '\n';
-            //ecc_vector = bounding_eccentricities(g, sources_pt, dists_vec, ranks_vec);
-            //std::cout << "mean of eccentricities of the spanner is: "  << vector_mean(ecc_vector)<< '\n'
-            //    << "variance of eccentricities of the spanner is: " << vector_var(ecc_vector) << '\n';
+
+    /**
+     ** spanner_graph():
+     **     params:  csr -> CSR graph for span building.
+     **              params -> spanner parameters (algorithm, BFS root selection strategy, number
+     **                        of BFS done, BFS backend). The CSR ordering is the one of csr.
+     **              pool -> threads used by the construction.
+     **              g -> igraph version of csr, or NULL when only the CSR graph is in memory.
+     **
+     **     Spanner construction on the CSR graph, by BFS trees merging, by Baswana-Sen
+     **     clustering or as an additive spanner. All of them fill an edge accumulator, so
+     **     the spanner has the same form. The igraph structure is only needed by the
+     **     community strategy and the igraph BFS backend: without g, a temporary copy is
+     **     created from csr for them.
+     **/
+
+    Graph::IgraphPtr spanner_graph(const Graph::CsrGraph &csr, const SpannerParams &params, Parallel::ThreadPool &pool,
+            igraph_t *g)
+    {
+        std::cout << "\n\t_______________________________\n\n" << "Computing very light spanner ...\n";
+
+        Graph::IgraphPtr csr_igraph;
+        bool own_igraph = !g && params.algorithm != SPANNER_ALGORITHM::BASWANA_SEN
+            && ((params.algorithm == SPANNER_ALGORITHM::BFS_MERGE && params.strat == BFS_STRATEGY::COMMUNITY)
+                || params.bfs_backend == BFS_BACKEND::IGRAPH);
+        if (own_igraph)
+        {
+            csr_igraph = csr.to_igraph();
+            g = csr_igraph.get();
         }
 
+        // Accumulate distinct edges of the spanner, sized for a few BFS trees
+        EdgeAccumulator span_edges(csr.get_vertices_nb(), 2 * static_cast<size_t>(csr.get_vertices_nb()));
+
+        if (params.algorithm == SPANNER_ALGORITHM::BASWANA_SEN)
+            baswana_sen_spanner(csr, params.k, params.bs_seed, pool, &span_edges);
+        else if (params.algorithm == SPANNER_ALGORITHM::ADDITIVE_2)
+            additive_spanner(csr, params, pool, g, &span_edges);
+        else
+            bfs_merge_spanner(csr, params, pool, g, &span_edges);
+
+        // Release the temporary igraph copy before the spanner one is built
+        csr_igraph.reset();
 
-        //std::cout << "Final very light spanner estimated diameter (by eccentricities maximum) is: "
-        //    << *(std::max_element(ecc_vector.begin(), ecc_vector.end())) << std::endl;
+        // Build the spanner igraph structure in a single construction
+        Report::ScopedPhase build_phase("build");
+        Graph::IgraphPtr span = span_edges.build_igraph(csr);
+        build_phase.stop();
 
         std::cout << "\nComputing very light spanner done." << std::endl;
 
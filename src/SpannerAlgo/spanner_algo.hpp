@@ -6,22 +6,116 @@
 #include <numeric>
 #include <iostream>
 #include <limits>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "bfs_engine.hpp"
+#include "edge_accumulator.hpp"
+#include "communities.hpp"
+#include "baswana_sen.hpp"
+#include "additive_spanner.hpp"
 
 
 #define RNG_SEED 42
 #define GAMMA_COMMUNITIES 0.0001
 
+// Default spanner edge budget, as a fraction of the graph edges:
+#define MAX_EDGE_RATIO 0.8
+
+// Stretch estimation of the incremental spanner: sampled vertices (fixed seed) and
+// maximum number of merged trees used as landmarks:
+#define STRETCH_ESTIMATE_SAMPLES 1024
+#define STRETCH_ESTIMATE_LANDMARKS 16
+
 
 
 namespace Spanner
 {
 
+    /**
+     ** BFS_STRATEGY enum:
+     **     Selection of the BFS roots.
+     **         RANDOM -> uniform random vertices.
+     **         COMMUNITY -> one vertex per Leiden community, largest communities first.
+     **         LABEL_PROPAGATION -> one vertex per label propagation community.
+     **         HIGH_DEGREE -> highest degree vertices.
+     **         FARTHEST_POINT -> greedy k-center: each root is the vertex farthest from the
+     **                           previous roots, chosen while the BFS are computed.
+     **/
+
     enum BFS_STRATEGY
     {
         RANDOM,
-        COMMUNITY
+        COMMUNITY,
+        LABEL_PROPAGATION,
+        HIGH_DEGREE,
+        FARTHEST_POINT
+    };
+
+
+    /**
+     ** SPANNER_ALGORITHM enum:
+     **     Construction of the spanner.
+     **         BFS_MERGE -> union of BFS trees from selected roots (see BFS_STRATEGY).
+     **         BASWANA_SEN -> randomized clustering (2k-1)-spanner of Baswana and Sen.
+     **         ADDITIVE_2 -> +2 spanner: edges of the low degree vertices and BFS trees from
+     **                       the centers of clusters dominating the high degree vertices.
+     **/
+
+    enum SPANNER_ALGORITHM
+    {
+        BFS_MERGE,
+        BASWANA_SEN,
+        ADDITIVE_2
+    };
+
+
+    /**
+     ** SpannerParams structure:
+     **     Tuning parameters of the spanner computation, filled from command line options.
+     **/
+
+    struct SpannerParams
+    {
+        SPANNER_ALGORITHM algorithm = SPANNER_ALGORITHM::BFS_MERGE; // spanner construction.
+        uint32_t k = 2; // Baswana-Sen stretch parameter (2k-1 multiplicative stretch).
+        uint64_t bs_seed = RNG_SEED; // seed of the Baswana-Sen cluster sampling.
+        uint32_t degree_threshold = 0; // additive spanner heavy vertex degree (0 for sqrt(n)).
+        BFS_STRATEGY strat = BFS_STRATEGY::RANDOM; // BFS root selection strategy.
+        int bfs_nb = 50; // maximum number of BFS done.
+        Graph::VertexOrdering ordering = Graph::VertexOrdering::NATURAL; // CSR relabeling.
+        bool compressed = false; // traverse the compressed neighbors lists of the CSR graph.
+        int threads_nb = 0; // number of threads, 0 for the number of cores.
+        BFS_BACKEND bfs_backend = BFS_BACKEND::QUEUE; // implementation of pre_compute_bfs().
+        double do_alpha = DO_BFS_ALPHA; // direction-optimizing top-down to bottom-up threshold.
+        double do_beta = DO_BFS_BETA; // direction-optimizing bottom-up to top-down threshold.
+        REPRESENTATIVE representative = REPRESENTATIVE::MAX_DEGREE; // BFS root of each community.
+        uint64_t representative_seed = RNG_SEED; // seed of the RANDOM_VERTEX representatives.
+        std::string communities_cache; // community cache file (empty for none).
+        uint64_t lp_seed = RNG_SEED; // seed of the label propagation.
+        double lp_threshold = LPA_THRESHOLD; // label propagation convergence threshold.
+        bool incremental = false; // compute each BFS only when its tree is going to be merged.
+        uint64_t max_edges = 0; // spanner edge budget (0 to use max_edge_ratio).
+        double max_edge_ratio = MAX_EDGE_RATIO; // spanner edge budget as a fraction of the graph edges.
+        double min_gain = 0.0; // stop when the new edges of a tree are less than this fraction of it.
+        std::string bfs_spill; // scratch file receiving the BFS results (empty to keep them in memory).
     };
 
-    igraph_t *spanner_graph(igraph_t *g, BFS_STRATEGY strat, int bfs_nb);
+
+    // Steps of the spanner construction:
+    std::vector<int> select_bfs_points(igraph_t *g, const Graph::CsrGraph &csr, const SpannerParams &params,
+            Parallel::ThreadPool &pool);
+    void pre_compute_bfs(igraph_t *g, BfsEngine &engine, const Graph::CsrGraph &csr, const std::vector<int> &sources_pt,
+            std::vector<BfsResult> *bfs_vec, const SpannerParams &params);
+    size_t merge_bfs_trees(EdgeAccumulator *span_edges, const Graph::CsrGraph &csr, const std::vector<BfsResult> &bfs_vec,
+            const SpannerParams &params);
+    size_t grow_spanner(igraph_t *g, BfsEngine &engine, const Graph::CsrGraph &csr, const std::vector<int> &sources_pt,
+            EdgeAccumulator *span_edges, const SpannerParams &params, Parallel::ThreadPool &pool);
+    uint64_t edge_budget(const Graph::CsrGraph &csr, const SpannerParams &params);
+
+    Graph::IgraphPtr spanner_graph(igraph_t *g, const SpannerParams &params, Parallel::ThreadPool &pool);
+    Graph::IgraphPtr spanner_graph(const Graph::CsrGraph &csr, const SpannerParams &params, Parallel::ThreadPool &pool,
+            igraph_t *g = NULL);
 
 } // namespace Spanner
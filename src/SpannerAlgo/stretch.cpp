@@ -0,0 +1,189 @@
+#include "stretch.hpp"
+
+#include <random>
+#include <algorithm>
+#include <iostream>
+
+
+namespace Spanner
+{
+
+    /**
+     ** merge():
+     **     params:  other -> partial statistics of another thread.
+     **
+     **     Add the counters and distributions of other to this one.
+     **/
+
+    void StretchStats::merge(const StretchStats &other)
+    {
+        this->pairs_nb += other.pairs_nb;
+        this->unreachable_nb += other.unreachable_nb;
+        this->additive_sum += other.additive_sum;
+        this->multiplicative_sum += other.multiplicative_sum;
+        this->max_multiplicative = std::max(this->max_multiplicative, other.max_multiplicative);
+
+        if (this->additive.size() < other.additive.size())
+            this->additive.resize(other.additive.size(), 0);
+        for (size_t i = 0; i < other.additive.size(); i++)
+            this->additive[i] += other.additive[i];
+
+        if (this->multiplicative.size() < other.multiplicative.size())
+            this->multiplicative.resize(other.multiplicative.size(), 0);
+        for (size_t i = 0; i < other.multiplicative.size(); i++)
+            this->multiplicative[i] += other.multiplicative[i];
+    }
+
+
+    /**
+     ** multiplicative_quantile():
+     **     params:  q -> quantile in [0, 1].
+     **
+     **     Return the multiplicative stretch below which a q fraction of the connected
+     **     pairs lies, up to the bin resolution.
+     **/
+
+    double StretchStats::multiplicative_quantile(double q) const
+    {
+        uint64_t reached = this->pairs_nb - this->unreachable_nb;
+        uint64_t target = q * reached;
+        uint64_t count = 0;
+
+        for (size_t bin = 0; bin < this->multiplicative.size(); bin++)
+        {
+            count += this->multiplicative[bin];
+            if (count > target)
+                return 1.0 + static_cast<double>(bin) / STRETCH_BINS_PER_UNIT;
+        }
+
+        return this->max_multiplicative;
+    }
+
+
+    /**
+     ** sample_sources():
+     **     params:  vertices_nb -> number of vertices of the graph.
+     **              sources_nb -> number of distinct sources to draw.
+     **              seed -> seed of the generator.
+     **
+     **     Draw distinct vertices uniformly with a fixed seed, so two runs (or two
+     **     spanners of the same graph) are evaluated on the same sources.
+     **/
+
+    static std::vector<uint32_t> sample_sources(uint32_t vertices_nb, size_t sources_nb, uint64_t seed)
+    {
+        std::vector<uint32_t> sources;
+        std::vector<bool> drawn(vertices_nb, false);
+        std::mt19937_64 generator(seed);
+        std::uniform_int_distribution<uint32_t> distribution(0, vertices_nb - 1);
+
+        sources_nb = std::min(sources_nb, static_cast<size_t>(vertices_nb));
+        while (sources.size() < sources_nb)
+        {
+            uint32_t v = distribution(generator);
+            if (!drawn[v])
+            {
+                drawn[v] = true;
+                sources.push_back(v);
+            }
+        }
+
+        return sources;
+    }
+
+
+    /**
+     ** evaluate_stretch():
+     **     params:  graph -> original graph (GCC).
+     **              spanner -> spanner of graph, on the same original vertex ids.
+     **              pool -> threads running the traversals.
+     **              sources_nb -> number of sampled sources.
+     **              seed -> seed of the sources sampling.
+     **
+     **     For each sampled source, one task traverses the graph, keeps its distances
+     **     in a compact array (1, 2 or 4 bytes per vertex, on the spanner ids), then
+     **     traverses the spanner in the same scratch buffers and compares the distances
+     **     of every reached vertex. Each thread fills its own statistics, merged at the end.
+     **/
+
+    StretchStats evaluate_stretch(const Graph::CsrGraph &graph, const Graph::CsrGraph &spanner,
+            Parallel::ThreadPool &pool, size_t sources_nb, uint64_t seed)
+    {
+        StretchStats res;
+
+        if (graph.get_vertices_nb() != spanner.get_vertices_nb())
+        {
+            std::cerr << "Error: the spanner and the graph have different vertices" << std::endl;
+            exit(1);
+        }
+
+        if (graph.get_vertices_nb() == 0)
+            return res;
+
+        std::vector<uint32_t> sources = sample_sources(graph.get_vertices_nb(), sources_nb, seed);
+        uint32_t vertices_nb = graph.get_vertices_nb();
+        BfsEngine graph_engine(graph, pool);
+        BfsEngine spanner_engine(spanner, graph_engine);
+        std::vector<StretchStats> partials(pool.get_threads_nb());
+        std::vector<std::vector<uint8_t>> graph_dists(pool.get_threads_nb());
+
+        pool.run(sources.size(), [&](size_t i, int thread_id)
+        {
+            StretchStats &stats = partials[thread_id];
+            std::vector<uint8_t> &compact = graph_dists[thread_id];
+            uint32_t source = sources[i];
+            int dist_bytes = 1;
+
+            graph_engine.visit(graph.to_internal(source), thread_id, [&](const BfsScratch &graph_bfs)
+            {
+                dist_bytes = dist_width(graph_bfs.dists[graph_bfs.queue.back()]);
+                compact.assign(static_cast<size_t>(vertices_nb) * dist_bytes, 0xFF);
+
+                for (uint32_t v : graph_bfs.queue)
+                    store_dist(compact.data(), dist_bytes, spanner.to_internal(graph.to_original(v)), graph_bfs.dists[v]);
+            });
+
+            spanner_engine.visit(spanner.to_internal(source), thread_id, [&](const BfsScratch &spanner_bfs)
+            {
+                for (uint32_t v = 0; v < vertices_nb; v++)
+                {
+                    uint32_t graph_dist = load_dist(compact.data(), dist_bytes, v);
+                    if (graph_dist == 0 || graph_dist == NO_VERTEX)
+                        continue;
+
+                    stats.pairs_nb++;
+
+                    uint32_t spanner_dist = spanner_bfs.dists[v];
+                    if (spanner_dist == NO_VERTEX)
+                    {
+                        stats.unreachable_nb++;
+                        continue;
+                    }
+
+                    // the spanner is a subgraph, so its distances are never shorter.
+                    uint32_t additive = spanner_dist - graph_dist;
+                    double multiplicative = static_cast<double>(spanner_dist) / graph_dist;
+                    size_t bin = static_cast<uint64_t>(additive) * STRETCH_BINS_PER_UNIT / graph_dist;
+
+                    if (stats.additive.size() <= additive)
+                        stats.additive.resize(additive + 1, 0);
+                    if (stats.multiplicative.size() <= bin)
+                        stats.multiplicative.resize(bin + 1, 0);
+
+                    stats.additive[additive]++;
+                    stats.multiplicative[bin]++;
+                    stats.additive_sum += additive;
+                    stats.multiplicative_sum += multiplicative;
+                    stats.max_multiplicative = std::max(stats.max_multiplicative, multiplicative);
+                }
+            });
+        });
+
+        res.sources_nb = sources.size();
+        for (const StretchStats &stats : partials)
+            res.merge(stats);
+
+        return res;
+    }
+
+} // namespace Spanner
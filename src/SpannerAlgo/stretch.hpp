@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "csr_graph.hpp"
+#include "thread_pool.hpp"
+#include "bfs_engine.hpp"
+
+
+// Resolution of the multiplicative stretch distribution (bins per unit of stretch):
+#define STRETCH_BINS_PER_UNIT 100
+
+
+namespace Spanner
+{
+
+    /**
+     ** StretchStats structure:
+     **     Distortion of the spanner distances over the sampled pairs (s, v), where s
+     **     is a sampled source and v any vertex reachable from s in the graph.
+     **     Distributions and means only count the pairs still connected in the spanner.
+     **/
+
+    struct StretchStats
+    {
+        size_t sources_nb = 0; // number of sampled sources.
+        uint64_t pairs_nb = 0; // number of pairs connected in the graph.
+        uint64_t unreachable_nb = 0; // pairs connected in the graph but not in the spanner.
+        std::vector<uint64_t> additive; // pairs by additive stretch d_S(s, v) - d_G(s, v).
+        std::vector<uint64_t> multiplicative; // pairs by bin of (d_S / d_G - 1) * STRETCH_BINS_PER_UNIT.
+        double additive_sum = 0.0; // sum of the additive stretches.
+        double multiplicative_sum = 0.0; // sum of the multiplicative stretches.
+        double max_multiplicative = 1.0; // largest multiplicative stretch.
+
+        void merge(const StretchStats &other);
+        double multiplicative_quantile(double q) const;
+    };
+
+
+    StretchStats evaluate_stretch(const Graph::CsrGraph &graph, const Graph::CsrGraph &spanner,
+            Parallel::ThreadPool &pool, size_t sources_nb, uint64_t seed);
+
+} // namespace Spanner
@@ -4,38 +4,182 @@
 #include "options.hpp"
 #include "graph_manager.hpp"
 
-static void print_results(igraph_t *graph, igraph_t *span, std::string filename)
+static void print_results(long gcc_vertices_nb, long gcc_edges_nb, igraph_t *span, std::string filename)
 {
     std::cout << "\n\t_______________________________\n\n" << "Final results of the Spanner on graph: "
         << filename << "\n\n" << "original Greatest component (GCC) graph size:\n"
-        << "\tnumber of vertices: " << igraph_vcount(graph) << '\n'
-        << "\tnumber of edges: " << igraph_ecount(graph) << '\n'
+        << "\tnumber of vertices: " << gcc_vertices_nb << '\n'
+        << "\tnumber of edges: " << gcc_edges_nb << '\n'
         << "\nVery light spanner graph size:\n"
         << "\tnumber of vertices: " << igraph_vcount(span) << '\n'
         << "\tnumber of edges: " << igraph_ecount(span) << std::endl;
 }
 
 
+static void print_eccentricities(std::string graph_name, const Spanner::EccentricityStats &stats)
+{
+    std::cout << "\nEccentricities of the " << graph_name << " (" << stats.bfs_nb << " BFS):\n"
+        << "\tmean: " << stats.mean << '\n'
+        << "\tvariance: " << stats.variance << '\n'
+        << "\tradius: " << stats.radius << '\n'
+        << "\tdiameter: " << stats.diameter << '\n'
+        << "\tdistribution (eccentricity: vertices):";
+
+    for (size_t ecc = stats.radius; ecc < stats.distribution.size(); ecc++)
+        std::cout << ' ' << ecc << ": " << stats.distribution[ecc];
+
+    std::cout << std::endl;
+}
+
+
+static void print_diameter(std::string graph_name, const Spanner::DiameterResult &res)
+{
+    std::cout << "\nDiameter of the " << graph_name << ": " << res.diameter << " (" << res.bfs_nb << " BFS)\n"
+        << "\tdiametral path:";
+
+    for (uint32_t v : res.path)
+        std::cout << ' ' << v;
+
+    std::cout << std::endl;
+}
+
+
+static void print_stretch(const Spanner::StretchStats &stats)
+{
+    uint64_t reached = stats.pairs_nb - stats.unreachable_nb;
+
+    std::cout << "\nStretch of the spanner from " << stats.sources_nb << " sampled sources ("
+        << stats.pairs_nb << " pairs):\n"
+        << "\tunreachable pairs: " << stats.unreachable_nb << '\n';
+
+    if (reached == 0)
+        return;
+
+    std::cout << "\tmean additive stretch: " << stats.additive_sum / reached << '\n'
+        << "\tmax additive stretch: " << stats.additive.size() - 1 << '\n'
+        << "\tmean multiplicative stretch: " << stats.multiplicative_sum / reached << '\n'
+        << "\tmultiplicative stretch p50 / p90 / p99: " << stats.multiplicative_quantile(0.5) << " / "
+        << stats.multiplicative_quantile(0.9) << " / " << stats.multiplicative_quantile(0.99) << '\n'
+        << "\tmax multiplicative stretch: " << stats.max_multiplicative << '\n'
+        << "\tdistribution (additive stretch: pairs):";
+
+    for (size_t add = 0; add < stats.additive.size(); add++)
+        std::cout << ' ' << add << ": " << stats.additive[add];
+
+    std::cout << std::endl;
+}
+
+
+static std::string algorithm_name(const Spanner::SpannerParams &params)
+{
+    switch (params.algorithm)
+    {
+    case Spanner::SPANNER_ALGORITHM::BASWANA_SEN:
+        return "baswana-sen k=" + std::to_string(params.k);
+    case Spanner::SPANNER_ALGORITHM::ADDITIVE_2:
+        return "additive";
+    default:
+        return "bfs-merge";
+    }
+}
+
+
 int main(int argc, char **argv)
 {
     // Read option parameters:
     Option::OptionParser op_parser(argc, argv);
 
+    Report::set_quiet(op_parser.get_quiet());
+
     // Instance graph manager and load graph from file:
-    Graph::GraphManager g_manager;
-    igraph_t *g = g_manager.load_graph(op_parser.get_filename());
+    Graph::GraphManager g_manager(op_parser.get_spanner_params().threads_nb);
+    long gcc_vertices_nb, gcc_edges_nb;
+
+    if (op_parser.get_low_memory())
+    {
+        // Stream the Greatest connected component only:
+        const Graph::CsrGraph &gcc_csr = g_manager.load_gcc_low_memory(op_parser.get_filename(),
+                op_parser.get_spanner_params().ordering, op_parser.get_spanner_params().compressed);
+        gcc_vertices_nb = gcc_csr.get_vertices_nb();
+        gcc_edges_nb = gcc_csr.get_edges_nb();
+    }
+    else
+    {
+        g_manager.load_graph(op_parser.get_filename());
 
-    // Compute Greatest connected component:
-    igraph_t *gcc = g_manager.compute_gcc();
+        // Compute Greatest connected component:
+        igraph_t *gcc = g_manager.compute_gcc();
+        gcc_vertices_nb = igraph_vcount(gcc);
+        gcc_edges_nb = igraph_ecount(gcc);
+
+        // Save the loaded graph or its GCC for faster next runs:
+        if (!op_parser.get_snapshot_filename().empty())
+            g_manager.save_snapshot(op_parser.get_snapshot_filename(),
+                    op_parser.get_snapshot_gcc() ? Graph::GraphSource::GCC : Graph::GraphSource::ORIGIN,
+                    op_parser.get_snapshot_degrees());
+    }
 
     // Extract light sub graph for testing:
     //igraph_t *sub_g = g_manager.extract_subgraph(0, 10000);
 
     // Create spanner of the graph:
-    igraph_t *span = g_manager.compute_spanner(Graph::GraphSource::GCC, op_parser.get_bfs_strategy(), op_parser.get_bfs_nb());
+    igraph_t *span = g_manager.compute_spanner(Graph::GraphSource::GCC, op_parser.get_spanner_params());
 
     // Print results:
-    print_results(gcc, span, op_parser.get_filename());
+    print_results(gcc_vertices_nb, gcc_edges_nb, span, op_parser.get_filename());
+
+    // Write the spanner with the input vertex ids:
+    if (!op_parser.get_output_filename().empty())
+        g_manager.write_spanner(op_parser.get_output_filename(), op_parser.get_output_format());
+
+    // Compare eccentricities of the GCC and of its spanner:
+    if (op_parser.get_eccentricities())
+    {
+        print_eccentricities("GCC", g_manager.compute_eccentricities(Graph::GraphSource::GCC));
+        print_eccentricities("spanner", g_manager.compute_eccentricities(Graph::GraphSource::SPANNER));
+    }
+
+    // Compare exact diameters of the GCC and of its spanner:
+    if (op_parser.get_diameter())
+    {
+        print_diameter("GCC", g_manager.compute_diameter(Graph::GraphSource::GCC));
+        print_diameter("spanner", g_manager.compute_diameter(Graph::GraphSource::SPANNER));
+    }
+
+    // Evaluate the spanner distortion on sampled sources (always done for the additive spanner):
+    const Spanner::SpannerParams &params = op_parser.get_spanner_params();
+    size_t eval_sources_nb = op_parser.get_eval_sources_nb();
+    if (eval_sources_nb == 0 && params.algorithm == Spanner::SPANNER_ALGORITHM::ADDITIVE_2)
+        eval_sources_nb = ADDITIVE_EVAL_SOURCES;
+
+    Spanner::StretchStats stretch;
+    if (eval_sources_nb > 0)
+    {
+        stretch = g_manager.evaluate_stretch(eval_sources_nb, op_parser.get_eval_seed());
+        print_stretch(stretch);
+    }
+
+    // Dump the measures of each phase:
+    if (!op_parser.get_report_filename().empty())
+    {
+        std::vector<std::pair<std::string, std::string>> run_info = {
+            {"graph", op_parser.get_filename()},
+            {"algorithm", algorithm_name(params)},
+            {"bfs_number", std::to_string(params.bfs_nb)},
+            {"threads", std::to_string(params.threads_nb)},
+            {"low_memory", op_parser.get_low_memory() ? "true" : "false"},
+            {"compressed", params.compressed ? "true" : "false"},
+            {"gcc_vertices", std::to_string(gcc_vertices_nb)},
+            {"gcc_edges", std::to_string(gcc_edges_nb)},
+            {"spanner_edges", std::to_string(static_cast<long>(igraph_ecount(span)))}
+        };
+
+        if (eval_sources_nb > 0)
+            run_info.push_back({"max_additive_stretch", std::to_string(stretch.additive.empty() ? 0
+                        : stretch.additive.size() - 1)});
+
+        Report::write_json(op_parser.get_report_filename(), run_info);
+    }
 
     return 0;
 }